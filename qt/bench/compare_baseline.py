@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Compara el JSON de una corrida del benchmark con una línea base guardada.
+
+    bench --benchmark_out=bench.json --benchmark_out_format=json
+    compare_baseline.py baseline.json bench.json [--threshold 10]
+    compare_baseline.py baseline.json bench.json --update   # guarda la corrida como base
+
+Sale con código 1 si algún benchmark es más lento que la base en más del
+umbral (en %), y con 2 si no hay base que comparar (salvo --allow-missing):
+una comparación que no compara nada no puede pasar. Con repeticiones se
+comparan las medianas.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import sys
+
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    """Nombre -> tiempo real en ns (mediana si hay repeticiones)."""
+    with open(path) as f:
+        data = json.load(f)
+    times = {}
+    medians = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        ns = bench["real_time"] * UNITS.get(bench.get("time_unit", "ns"), 1.0)
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = ns
+        else:
+            times.setdefault(bench.get("run_name", bench["name"]), ns)
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="regresión tolerada en %% (10)")
+    parser.add_argument("--update", action="store_true", help="copia la corrida actual sobre la base")
+    parser.add_argument("--allow-missing", action="store_true", help="sin base, avisa y sale con 0")
+    args = parser.parse_args()
+
+    if args.update:
+        shutil.copyfile(args.current, args.baseline)
+        print(f"Baseline updated: {args.baseline}")
+        return 0
+    if not os.path.exists(args.baseline):
+        print(f"No baseline at {args.baseline}; run with --update to store one")
+        return 0 if args.allow_missing else 2
+
+    base = load(args.baseline)
+    current = load(args.current)
+    regressions = []
+    print(f"{'benchmark':<70} {'base':>12} {'now':>12} {'change':>8}")
+    for name in sorted(current):
+        if name not in base:
+            print(f"{name:<70} {'-':>12} {current[name]:>12.0f} {'new':>8}")
+            continue
+        change = 100.0 * (current[name] - base[name]) / base[name] if base[name] > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            regressions.append(name)
+            mark = "  <-- slower"
+        print(f"{name:<70} {base[name]:>12.0f} {current[name]:>12.0f} {change:>+7.1f}%{mark}")
+    missing = sorted(set(base) - set(current))
+    for name in missing:
+        print(f"{name:<70} {base[name]:>12.0f} {'-':>12} {'gone':>8}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmarks slower than the baseline by more than {args.threshold:.0f}%")
+        return 1
+    print(f"\nNo regressions above {args.threshold:.0f}% (times in ns)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
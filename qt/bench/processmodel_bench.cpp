@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include "../processmodel.h"
+#include "../scheduler.h"
+#include "workloads.h"
+#include <map>
+
+namespace {
+
+constexpr int kQuantum = 3;
+constexpr int kModelResources = 16;
+// Patrón extra: llegadas cada 11 ticks, más que la ráfaga máxima, así que
+// nunca hay dos procesos vivos a la vez
+constexpr int kSpaced = 3;
+
+struct ModelFIFO {
+    static constexpr ModelPolicy policy = ModelPolicy::FIFO;
+    static void predict(std::vector<Process>& p) { SchedulingAlgorithms::runFIFO(p); }
+};
+
+struct ModelSJF {
+    static constexpr ModelPolicy policy = ModelPolicy::SJF;
+    static void predict(std::vector<Process>& p) { SchedulingAlgorithms::runSJF(p); }
+};
+
+struct ModelRoundRobin {
+    static constexpr ModelPolicy policy = ModelPolicy::ROUND_ROBIN;
+    static void predict(std::vector<Process>& p) { SchedulingAlgorithms::runRoundRobin(p, kQuantum); }
+};
+
+struct ModelPriority {
+    static constexpr ModelPolicy policy = ModelPolicy::PRIORITY;
+    static void predict(std::vector<Process>& p) { SchedulingAlgorithms::runPriority(p, false); }
+};
+
+std::vector<Process> modelProcesses(int count, int pattern) {
+    if (pattern != kSpaced) {
+        return workloads::makeProcesses(count, static_cast<workloads::ArrivalPattern>(pattern));
+    }
+    auto processes = workloads::makeProcesses(count, workloads::ArrivalPattern::UNIFORM);
+    for (int i = 0; i < count; i++) {
+        processes[i].arrival_time = 11 * i;
+    }
+    return processes;
+}
+
+// Procesos solo de CPU: el motor por eventos frente a SchedulingAlgorithms
+// con la misma carga en orden de llegada. wait_mismatches cuenta los
+// procesos cuya espera difiere (debería ser 0).
+// range(0) = procesos, range(1) = ArrivalPattern
+template <class Policy>
+void BM_ProcessModel(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto processes = modelProcesses(count, static_cast<int>(state.range(1)));
+    const ProcessModel model = ProcessModel::fromWorkload(processes, {});
+
+    ProcessModelResult result;
+    for (auto _ : state) {
+        result = model.run(Policy::policy, kQuantum, nullptr);
+        benchmark::DoNotOptimize(result.timeline.data());
+    }
+
+    std::vector<Process> predicted = processes;
+    Policy::predict(predicted);
+    std::map<QString, int> predicted_wait;
+    for (const auto& process : predicted) {
+        predicted_wait[process.pid] = process.waiting_time;
+    }
+    int mismatches = 0;
+    for (const auto& process : result.processes) {
+        mismatches += predicted_wait[process.pid] != process.waiting_time ? 1 : 0;
+    }
+    state.counters["wait_mismatches"] = mismatches;
+    state.counters["avg_wait"] = SchedulingAlgorithms::calculateAverageWaitingTime(result.processes);
+    state.counters["peak_frames"] = static_cast<double>(result.peak_frames);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Cada proceso retiene un cerrojo (de kModelResources) sus dos primeros
+// ticks. peak_frames muestra que la memoria sigue a los procesos vivos:
+// con llegadas espaciadas se queda en 1 sea cual sea la carga.
+// range(0) = procesos, range(1) = ArrivalPattern
+void BM_ProcessModelLocks(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto processes = modelProcesses(count, static_cast<int>(state.range(1)));
+    std::vector<Action> actions;
+    actions.reserve(count);
+    for (int i = 0; i < count; i++) {
+        actions.push_back(Action(processes[i].pid, "WRITE", QString("R%1").arg(i % kModelResources),
+                                 processes[i].arrival_time, std::min(2, processes[i].burst_time)));
+    }
+    const ProcessModel model = ProcessModel::fromWorkload(processes, actions);
+    const auto resources = workloads::makeResources(kModelResources, 1);
+
+    ProcessModelResult result;
+    for (auto _ : state) {
+        MutexLock mechanism(resources);
+        result = model.run(ModelPolicy::FIFO, kQuantum, &mechanism);
+        benchmark::DoNotOptimize(result.timeline.data());
+    }
+    long long blocked = 0;
+    for (const auto& stats : result.stats) {
+        blocked += stats.blocked_time;
+    }
+    state.counters["peak_frames"] = static_cast<double>(result.peak_frames);
+    state.counters["blocked_ticks"] = static_cast<double>(blocked);
+    state.counters["deadlocked"] = static_cast<double>(result.deadlocked.size());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+// Los de vector recorren la cola de listos en cada despacho: la predicción
+// de SJF y Priority se queda en 10^5
+BENCHMARK_TEMPLATE(BM_ProcessModel, ModelFIFO)
+    ->ArgNames({"n", "arrivals"})->ArgsProduct({{1000, 100000}, {0, 1, 2, kSpaced}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ProcessModel, ModelSJF)
+    ->ArgNames({"n", "arrivals"})->ArgsProduct({{1000, 100000}, {0, 1, 2, kSpaced}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ProcessModel, ModelRoundRobin)
+    ->ArgNames({"n", "arrivals"})->ArgsProduct({{1000, 100000}, {0, 1, 2, kSpaced}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ProcessModel, ModelPriority)
+    ->ArgNames({"n", "arrivals"})->ArgsProduct({{1000, 100000}, {0, 1, 2, kSpaced}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ProcessModelLocks)
+    ->ArgNames({"n", "arrivals"})->ArgsProduct({{1000, 1000000}, {0, 2, kSpaced}})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,233 @@
+#include <benchmark/benchmark.h>
+#include "../scheduler.h"
+#include "../loader.h"
+#include "../schedtrace.h"
+#include "workloads.h"
+#include <QFile>
+#include <QTextStream>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+
+// Un algoritmo por tipo para instanciar el mismo benchmark con todos
+struct RunFIFO {
+    static std::vector<ExecutionSlice> run(std::vector<Process>& p) { return SchedulingAlgorithms::runFIFO(p); }
+    static void stream(ProcessStream& s, const SchedulingAlgorithms::SliceSink& slice,
+                       const SchedulingAlgorithms::ProcessSink& finish) {
+        SchedulingAlgorithms::runFIFO(s, slice, finish);
+    }
+};
+
+struct RunSJF {
+    static std::vector<ExecutionSlice> run(std::vector<Process>& p) { return SchedulingAlgorithms::runSJF(p); }
+    static void stream(ProcessStream& s, const SchedulingAlgorithms::SliceSink& slice,
+                       const SchedulingAlgorithms::ProcessSink& finish) {
+        SchedulingAlgorithms::runSJF(s, slice, finish);
+    }
+};
+
+struct RunSRT {
+    static std::vector<ExecutionSlice> run(std::vector<Process>& p) { return SchedulingAlgorithms::runSRT(p); }
+    static void stream(ProcessStream& s, const SchedulingAlgorithms::SliceSink& slice,
+                       const SchedulingAlgorithms::ProcessSink& finish) {
+        SchedulingAlgorithms::runSRT(s, slice, finish);
+    }
+};
+
+struct RunRoundRobin {
+    static std::vector<ExecutionSlice> run(std::vector<Process>& p) { return SchedulingAlgorithms::runRoundRobin(p, 3); }
+    static void stream(ProcessStream& s, const SchedulingAlgorithms::SliceSink& slice,
+                       const SchedulingAlgorithms::ProcessSink& finish) {
+        SchedulingAlgorithms::runRoundRobin(s, 3, slice, finish);
+    }
+};
+
+struct RunPriority {
+    static std::vector<ExecutionSlice> run(std::vector<Process>& p) { return SchedulingAlgorithms::runPriority(p, true, 5); }
+    static void stream(ProcessStream& s, const SchedulingAlgorithms::SliceSink& slice,
+                       const SchedulingAlgorithms::ProcessSink& finish) {
+        SchedulingAlgorithms::runPriority(s, true, 5, slice, finish);
+    }
+};
+
+// Archivo temporal que se borra al salir del benchmark
+class TempFile {
+public:
+    explicit TempFile(const char* name)
+        : path(QString::fromStdString((std::filesystem::temp_directory_path() / name).string())) {}
+    ~TempFile() { std::remove(path.toStdString().c_str()); }
+    const QString& name() const { return path; }
+
+private:
+    QString path;
+};
+
+void writeProcesses(const QString& path, const std::vector<Process>& processes) {
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Text);
+    QTextStream out(&file);
+    for (const auto& p : processes) {
+        out << p.pid << ", " << p.burst_time << ", " << p.arrival_time << ", " << p.priority << "\n";
+    }
+}
+
+void writeActions(const QString& path, const std::vector<Action>& actions) {
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Text);
+    QTextStream out(&file);
+    for (const auto& a : actions) {
+        out << a.pid << ", " << a.type << ", " << a.resource << ", " << a.cycle << "\n";
+    }
+}
+
+// Volcado tipo `perf sched script`: cambios de contexto entre 64 tareas en
+// una CPU, con un despertar antes de cada una que vuelve de dormir
+void writeSchedTrace(const QString& path, int lines) {
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Text);
+    QTextStream out(&file);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> task(1, 64);
+    std::uniform_int_distribution<int> ran(50, 5000);
+    long long us = 1000000;
+    int prev = task(rng);
+    for (int i = 0; i < lines; i += 2) {
+        const int next = task(rng);
+        const bool sleeps = rng() % 2 == 0;
+        const QString stamp = QString::number(us / 1000000) + "." + QString::number(us % 1000000).rightJustified(6, '0');
+        out << "  task" << next << " " << next << " [000] " << stamp << ": sched:sched_wakeup: comm=task" << next
+            << " pid=" << next << " prio=120 target_cpu=000\n";
+        out << "  task" << prev << " " << prev << " [000] " << stamp << ": sched:sched_switch: prev_comm=task" << prev
+            << " prev_pid=" << prev << " prev_prio=120 prev_state=" << (sleeps ? "S" : "R") << " ==> next_comm=task"
+            << next << " next_pid=" << next << " next_prio=120\n";
+        us += ran(rng);
+        prev = next;
+    }
+}
+
+// range(0) = procesos, range(1) = ArrivalPattern
+template <class Algorithm>
+void BM_Schedule(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto processes = workloads::makeProcesses(count, static_cast<workloads::ArrivalPattern>(state.range(1)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Process> copy = processes;
+        state.ResumeTiming();
+        std::vector<ExecutionSlice> timeline = Algorithm::run(copy);
+        benchmark::DoNotOptimize(timeline.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Variante en streaming: lee el archivo con ProcessStream mientras simula
+template <class Algorithm>
+void BM_ScheduleStream(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    TempFile file("bench_stream_processes.txt");
+    writeProcesses(file.name(), workloads::makeProcesses(count, static_cast<workloads::ArrivalPattern>(state.range(1))));
+
+    for (auto _ : state) {
+        ProcessStream source(file.name());
+        long long slices = 0;
+        long long finished = 0;
+        Algorithm::stream(source, [&slices](const ExecutionSlice&) { slices++; },
+                          [&finished](const Process&) { finished++; });
+        benchmark::DoNotOptimize(slices);
+        benchmark::DoNotOptimize(finished);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_LoadProcesses(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    TempFile file("bench_load_processes.txt");
+    writeProcesses(file.name(), workloads::makeProcesses(count, workloads::ArrivalPattern::UNIFORM));
+
+    for (auto _ : state) {
+        std::vector<Process> processes = loadProcesses(file.name());
+        benchmark::DoNotOptimize(processes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_LoadActions(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    TempFile file("bench_load_actions.txt");
+    writeActions(file.name(), workloads::makeActions(count, 256, 16, count / 8 + 1));
+
+    for (auto _ : state) {
+        std::vector<Action> actions = loadActions(file.name());
+        benchmark::DoNotOptimize(actions.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_LoadResources(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    TempFile file("bench_load_resources.txt");
+    {
+        QFile out_file(file.name());
+        out_file.open(QIODevice::WriteOnly | QIODevice::Text);
+        QTextStream out(&out_file);
+        for (int r = 0; r < count; r++) {
+            out << "R" << r << ", " << (1 + r % 4) << "\n";
+        }
+    }
+
+    for (auto _ : state) {
+        std::vector<Resource> resources = loadResources(file.name());
+        benchmark::DoNotOptimize(resources.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// range(0) = líneas del volcado
+void BM_LoadSchedTrace(benchmark::State& state) {
+    const int lines = static_cast<int>(state.range(0));
+    TempFile file("bench_sched_trace.txt");
+    writeSchedTrace(file.name(), lines);
+
+    for (auto _ : state) {
+        std::vector<Process> processes = loadSchedTrace(file.name());
+        benchmark::DoNotOptimize(processes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * lines);
+}
+
+// Tamaños de 10 en 10 hasta `max`, con los tres patrones de llegada
+template <int Max>
+void SizesAndPatterns(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "arrivals"});
+    for (long long n = 10; n <= Max; n *= 10) {
+        for (int pattern = 0; pattern < 3; pattern++) {
+            b->Args({n, pattern});
+        }
+    }
+}
+
+} // namespace
+
+// Los de vector en SJF, SRT y Priority recorren toda la cola de listos en
+// cada despacho (y SRT en cada tick): hasta 10^5. En streaming, SJF y SRT
+// usan montículos, RR una deque y Priority una cola por prioridad original
+// (coste por despacho según las prioridades distintas en espera, 5 aquí):
+// todas llegan a 10^7.
+BENCHMARK_TEMPLATE(BM_Schedule, RunFIFO)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Schedule, RunSJF)->Apply(SizesAndPatterns<100000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Schedule, RunSRT)->Apply(SizesAndPatterns<100000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Schedule, RunRoundRobin)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Schedule, RunPriority)->Apply(SizesAndPatterns<100000>)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_ScheduleStream, RunFIFO)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ScheduleStream, RunSJF)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ScheduleStream, RunSRT)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ScheduleStream, RunRoundRobin)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ScheduleStream, RunPriority)->Apply(SizesAndPatterns<10000000>)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_LoadProcesses)->RangeMultiplier(10)->Range(10, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadActions)->RangeMultiplier(10)->Range(10, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadResources)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadSchedTrace)->RangeMultiplier(10)->Range(10, 10000000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,468 @@
+#include <benchmark/benchmark.h>
+#include "../synchronizer.h"
+#include "../concurrentsync.h"
+#include "../timingwheel.h"
+#include "workloads.h"
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+
+namespace {
+
+// Mismo mecanismo visto solo a través de la interfaz virtual, para comparar
+// con el despacho estático que simulateSynchronizationLog usa para él
+template <class Inner>
+class VirtualOnly : public SynchronizationMechanism {
+private:
+    Inner inner;
+
+public:
+    explicit VirtualOnly(const std::vector<Resource>& res) : inner(res) {
+        // Mismos ids que `inner` para los recursos declarados
+        for (const auto& resource : res) {
+            resourceId(resource.name);
+        }
+    }
+    bool tryAcquire(int resource, int pid, AccessType type) override { return inner.tryAcquire(resource, pid, type); }
+    void release(int resource, int pid) override { inner.release(resource, pid); }
+    bool isAvailable(int resource) const override { return inner.isAvailable(resource); }
+    void resetResources() override { inner.resetResources(); }
+};
+
+constexpr int kProcesses = 256;
+constexpr int kResources = 16;
+
+// range(0) = acciones, range(1) = ArrivalPattern de sus ciclos
+template <class Mechanism>
+void BM_SimulateSynchronization(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto resources = workloads::makeResources(kResources, 3);
+    auto actions = workloads::makeActions(count, kProcesses, kResources, count / 8 + 1);
+    workloads::shapeArrivals(actions, static_cast<workloads::ArrivalPattern>(state.range(1)), count / 8 + 1);
+    const auto processes = workloads::makeSyncProcesses(actions);
+
+    for (auto _ : state) {
+        Mechanism mechanism(resources);
+        SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, &mechanism, 1);
+        benchmark::DoNotOptimize(log.intervals.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// La versión que expande a un SyncEvent por ciclo, como la usa la interfaz
+template <class Mechanism>
+void BM_SimulateSynchronizationEvents(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto resources = workloads::makeResources(kResources, 3);
+    auto actions = workloads::makeActions(count, kProcesses, kResources, count / 8 + 1);
+    workloads::shapeArrivals(actions, static_cast<workloads::ArrivalPattern>(state.range(1)), count / 8 + 1);
+    const auto processes = workloads::makeSyncProcesses(actions);
+
+    for (auto _ : state) {
+        Mechanism mechanism(resources);
+        std::vector<SyncEvent> events = SynchronizationSimulator::simulateSynchronization(processes, resources, actions, &mechanism, 1);
+        benchmark::DoNotOptimize(events.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Estados de todos los procesos en cada ciclo de una simulación: la salida
+// crece con procesos x ciclos
+void BM_GetProcessStates(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto resources = workloads::makeResources(kResources, 3);
+    const auto actions = workloads::makeActions(count, kProcesses, kResources, count / 8 + 1);
+    const auto processes = workloads::makeSyncProcesses(actions);
+    MutexLock mechanism(resources);
+    const SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, &mechanism, 1);
+    const std::vector<SyncEvent> events = log.toEvents();
+
+    for (auto _ : state) {
+        std::vector<SyncProcessState> states = SynchronizationSimulator::getProcessStates(processes, events, log.last_cycle);
+        benchmark::DoNotOptimize(states.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["cycles"] = log.last_cycle;
+}
+
+constexpr int kClusters = 64;
+
+// Mecanismos de BM_SimulatePartitioned, construidos sobre la traza
+template <class Mechanism>
+struct Plain {
+    static std::unique_ptr<SynchronizationMechanism> make(const std::vector<Process>&, const std::vector<Action>&) {
+        return std::make_unique<Mechanism>(std::vector<Resource>());
+    }
+};
+
+template <PriorityProtocol protocol>
+struct PriorityMutex {
+    static std::unique_ptr<SynchronizationMechanism> make(const std::vector<Process>& processes,
+                                                          const std::vector<Action>& actions) {
+        return std::make_unique<MutexLock>(std::vector<Resource>(), processes, actions, protocol);
+    }
+};
+
+bool sameLog(const SyncLog& a, const SyncLog& b) {
+    if (a.intervals.size() != b.intervals.size() || a.deadlocks.size() != b.deadlocks.size() ||
+        a.last_cycle != b.last_cycle) {
+        return false;
+    }
+    for (size_t k = 0; k < a.intervals.size(); k++) {
+        const SyncInterval& x = a.intervals[k];
+        const SyncInterval& y = b.intervals[k];
+        if (x.pid != y.pid || x.resource != y.resource || x.type != y.type || x.state != y.state ||
+            x.start_cycle != y.start_cycle || x.end_cycle != y.end_cycle || x.action != y.action) {
+            return false;
+        }
+    }
+    for (size_t k = 0; k < a.deadlocks.size(); k++) {
+        if (a.deadlocks[k].cycle != b.deadlocks[k].cycle || a.deadlocks[k].pids != b.deadlocks[k].pids ||
+            a.deadlocks[k].resources != b.deadlocks[k].resources) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Traza con grupos independientes y prioridades 1..5; range(1) = hilos (1 es
+// el motor en serie). Con más hilos el registro se compara una vez con el del
+// motor en serie y la prueba falla si no es idéntico.
+template <class Make>
+void BM_SimulatePartitioned(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const unsigned threads = static_cast<unsigned>(state.range(1));
+    const auto actions = workloads::makeClusteredActions(count, kClusters, kProcesses / 8, 4, count / 8 + 1);
+    auto processes = workloads::makeSyncProcesses(actions);
+    for (size_t p = 0; p < processes.size(); p++) {
+        processes[p].priority = 1 + static_cast<int>(p % 5);
+    }
+    const std::vector<Resource> resources;
+
+    if (threads > 1) {
+        auto serial = Make::make(processes, actions);
+        auto parallel = Make::make(processes, actions);
+        if (!sameLog(SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, serial.get(), 1),
+                     SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, parallel.get(), threads))) {
+            state.SkipWithError("partitioned log differs from the serial one");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        auto mechanism = Make::make(processes, actions);
+        SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, mechanism.get(), threads);
+        benchmark::DoNotOptimize(log.intervals.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Chequeo de seguridad del banquero con muchos tipos de recurso y procesos;
+// range(1) = tipos de recurso
+void BM_BankerSafety(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const int types = static_cast<int>(state.range(1));
+    const auto resources = workloads::makeResources(types, 4);
+    auto actions = workloads::makeActions(count, 2048, types, count / 8 + 1);
+    for (auto& action : actions) {
+        action.duration = 3;
+    }
+    const auto processes = workloads::makeSyncProcesses(actions);
+    const auto claims = Banker::claimsFromActions(actions, resources);
+
+    for (auto _ : state) {
+        Banker mechanism(resources, claims);
+        SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, &mechanism, 1);
+        benchmark::DoNotOptimize(log.intervals.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Políticas lector/escritor sobre una traza de 90% lecturas; range(0) = RWPolicy.
+// Los contadores reportan la espera de los escritores y el throughput simulado.
+void BM_RWPolicy(benchmark::State& state) {
+    const auto policy = static_cast<RWPolicy>(state.range(0));
+    const auto resources = workloads::makeResources(kResources, 8);
+    auto actions = workloads::makeActions(1 << 16, 1 << 16, kResources, (1 << 16) / 4);
+    std::mt19937 rng(7);
+    for (auto& action : actions) {
+        action.type = rng() % 10 == 0 ? "WRITE" : "READ";
+        action.duration = 1 + static_cast<int>(rng() % 3);
+    }
+    const auto processes = workloads::makeSyncProcesses(actions);
+
+    RWReport report;
+    for (auto _ : state) {
+        Semaphore mechanism(resources, policy);
+        SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, &mechanism, 1);
+        report = log.rwReport();
+    }
+    state.counters["writer_p50"] = report.writer_wait_p50;
+    state.counters["writer_p95"] = report.writer_wait_p95;
+    state.counters["writer_p99"] = report.writer_wait_p99;
+    state.counters["writer_max"] = report.writer_wait_max;
+    state.counters["starved_writers"] = report.starved_writers;
+    state.counters["accesses_per_cycle"] = report.throughput;
+}
+
+// Colas del mutex con prioridades 1..5 y secciones anidadas; range(0) = 0 para
+// FIFO o PriorityProtocol + 1. Los contadores miden el bloqueo de los procesos
+// más prioritarios y la inversión total.
+void BM_PriorityProtocol(benchmark::State& state) {
+    const int mode = static_cast<int>(state.range(0));
+    const std::vector<Resource> resources;
+    const auto actions = workloads::makeNestedActions(1 << 13, kResources, 1 << 13, 4);
+    auto processes = workloads::makeSyncProcesses(actions);
+    for (size_t p = 0; p < processes.size(); p++) {
+        processes[p].priority = 1 + static_cast<int>(p % 5);
+    }
+
+    std::vector<PriorityBlocking> report;
+    size_t deadlocks = 0;
+    for (auto _ : state) {
+        std::unique_ptr<MutexLock> mechanism = mode == 0
+            ? std::make_unique<MutexLock>(resources)
+            : std::make_unique<MutexLock>(resources, processes, actions, static_cast<PriorityProtocol>(mode - 1));
+        SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, mechanism.get(), 1);
+        report = log.priorityBlocking();
+        deadlocks = log.deadlocks.size();
+    }
+    int worst = 0, worst_inversion = 0, inversion = 0;
+    for (const auto& entry : report) {
+        if (entry.priority == 1) {
+            worst = std::max(worst, entry.worst_blocking);
+            worst_inversion = std::max(worst_inversion, entry.worst_inversion);
+        }
+        inversion += entry.inversion_cycles;
+    }
+    state.counters["top_worst_blocking"] = worst;
+    state.counters["top_worst_inversion"] = worst_inversion;
+    state.counters["inversion_cycles"] = inversion;
+    state.counters["deadlocks"] = static_cast<double>(deadlocks);
+}
+
+// Implementaciones de cerrojo sobre la misma traza con contención; range(0) =
+// LockKind. Los contadores estiman la CPU perdida, el traspaso entre dueños y
+// el último ciclo simulado (el traspaso alarga las secciones críticas).
+void BM_LockCostModel(benchmark::State& state) {
+    const auto kind = static_cast<LockKind>(state.range(0));
+    const std::vector<Resource> resources;
+    auto actions = workloads::makeActions(1 << 15, 1, kResources, 1 << 14);
+    std::mt19937 rng(13);
+    for (size_t i = 0; i < actions.size(); i++) {
+        // Un hilo por acción: cada uno entra una vez al camino caliente
+        actions[i].pid = QString("T%1").arg(i);
+        actions[i].duration = 1 + static_cast<int>(rng() % 3);
+    }
+    const auto processes = workloads::makeSyncProcesses(actions);
+
+    LockCostReport report;
+    int last_cycle = 0;
+    for (auto _ : state) {
+        CostModelLock mechanism(resources, kind);
+        SyncLog log = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, &mechanism, 1);
+        report = mechanism.costReport();
+        last_cycle = log.last_cycle;
+    }
+    state.counters["wasted_cycles"] = static_cast<double>(report.wasted_cycles);
+    state.counters["handoff_p50"] = report.handoff_p50;
+    state.counters["handoff_p99"] = report.handoff_p99;
+    state.counters["line_transfers"] = static_cast<double>(report.line_transfers);
+    state.counters["context_switches"] = report.context_switches;
+    state.counters["last_cycle"] = last_cycle;
+}
+
+// Lecturas frente a escrituras en una traza de 90% lecturas, un hilo por
+// acción; range(0): 0 = Semaphore (preferencia lectores), 1 = RCU, 2 = seqlock
+void BM_ReadMostly(benchmark::State& state) {
+    const int kind = static_cast<int>(state.range(0));
+    const auto resources = workloads::makeResources(kResources, 8);
+    auto actions = workloads::makeActions(1 << 16, 1, kResources, 1 << 14);
+    std::mt19937 rng(7);
+    for (size_t i = 0; i < actions.size(); i++) {
+        actions[i].pid = QString("T%1").arg(i);
+        actions[i].type = rng() % 10 == 0 ? "WRITE" : "READ";
+        actions[i].duration = 1 + static_cast<int>(rng() % 3);
+    }
+
+    ReadMostlyReport report;
+    for (auto _ : state) {
+        if (kind == 0) {
+            Semaphore mechanism(resources);
+            report = SynchronizationSimulator::simulateSynchronizationLog({}, resources, actions, &mechanism, 1)
+                         .readMostlyReport();
+        } else if (kind == 1) {
+            RCULock mechanism(resources);
+            report = mechanism.report(SynchronizationSimulator::simulateSynchronizationLog({}, resources, actions, &mechanism, 1));
+        } else {
+            SeqLock mechanism(resources);
+            report = mechanism.report(SynchronizationSimulator::simulateSynchronizationLog({}, resources, actions, &mechanism, 1));
+        }
+    }
+    state.counters["reads_per_cycle"] = report.read_throughput;
+    state.counters["reader_wait_max"] = report.reader_wait_max;
+    state.counters["writer_wait_p99"] = report.writer_wait_p99;
+    state.counters["writer_cost_p99"] = report.writer_cost_p99;
+    state.counters["read_retries"] = report.read_retries;
+}
+
+// Adaptadores para medir cada primitiva real con el mismo bucle; las
+// exclusivas tratan las lecturas como escrituras
+struct StdMutex {
+    std::mutex mutex;
+    void lock(int, bool) { mutex.lock(); }
+    void unlock(int, bool) { mutex.unlock(); }
+    LockStats stats() const { return LockStats(); }
+};
+
+struct StdSharedMutex {
+    std::shared_mutex mutex;
+    void lock(int, bool write) { write ? mutex.lock() : mutex.lock_shared(); }
+    void unlock(int, bool write) { write ? mutex.unlock() : mutex.unlock_shared(); }
+    LockStats stats() const { return LockStats(); }
+};
+
+struct FutexMutex {
+    ConcurrentMutexLock mutex{workloads::makeResources(1, 1)};
+    void lock(int pid, bool) { mutex.acquire(0, pid, AccessType::WRITE); }
+    void unlock(int pid, bool) { mutex.release(0, pid); }
+    LockStats stats() const { return mutex.stats(0); }
+};
+
+struct FutexSemaphore {
+    ConcurrentSemaphore semaphore{workloads::makeResources(1, 64)};
+    void lock(int pid, bool write) { semaphore.acquire(0, pid, write ? AccessType::WRITE : AccessType::READ); }
+    void unlock(int pid, bool) { semaphore.release(0, pid); }
+    LockStats stats() const { return semaphore.stats(0); }
+};
+
+// Un cerrojo compartido por todos los hilos con una sección crítica corta;
+// range(0) = porcentaje de escrituras. Los contadores propios solo los dan
+// las versiones futex (los de std quedan a cero).
+template <class Lock>
+void BM_ConcurrentLock(benchmark::State& state) {
+    static Lock lock;
+    static uint64_t shared_value = 0;
+    const int write_percent = static_cast<int>(state.range(0));
+    const int pid = state.thread_index();
+    const LockStats before = lock.stats();
+
+    uint64_t i = static_cast<uint64_t>(pid);
+    uint64_t local = 0;
+    for (auto _ : state) {
+        const bool write = static_cast<int>(i++ % 100) < write_percent;
+        lock.lock(pid, write);
+        if (write) {
+            shared_value++;
+        } else {
+            local += shared_value;
+        }
+        lock.unlock(pid, write);
+    }
+    benchmark::DoNotOptimize(local);
+
+    if (pid == 0) {
+        // Hilo 0: diferencia de los contadores del cerrojo durante la prueba
+        const LockStats after = lock.stats();
+        const double acquisitions = static_cast<double>(after.acquisitions - before.acquisitions);
+        if (acquisitions > 0) {
+            state.counters["contended_pct"] = 100.0 * (after.contended - before.contended) / acquisitions;
+            state.counters["wait_ns_per_op"] = (after.wait_ns - before.wait_ns) / acquisitions;
+            state.counters["hold_ns_per_op"] = (after.hold_ns - before.hold_ns) / acquisitions;
+        }
+    }
+}
+
+
+// Colas de eventos con la misma interfaz: sacar todo lo del próximo instante
+struct HeapQueue {
+    using Entry = std::pair<long long, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    void push(long long time, int value) { heap.push({time, value}); }
+    long long pop(std::vector<int>& out) {
+        const long long time = heap.top().first;
+        while (!heap.empty() && heap.top().first == time) {
+            out.push_back(heap.top().second);
+            heap.pop();
+        }
+        return time;
+    }
+};
+
+struct WheelQueue {
+    TimingWheel<int> wheel;
+    void push(long long time, int value) { wheel.push(time, value); }
+    long long pop(std::vector<int>& out) { return wheel.pop(out); }
+};
+
+// Modelo "hold": range(0) eventos pendientes; cada evento que vence se vuelve
+// a programar con un retraso uniforme en [1, range(1)]
+template <class Queue>
+void BM_EventQueue(benchmark::State& state) {
+    const int pending = static_cast<int>(state.range(0));
+    const int max_delay = static_cast<int>(state.range(1));
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> delay(1, max_delay);
+    std::vector<int> delays(1 << 16);
+    for (auto& d : delays) d = delay(rng);
+
+    Queue queue;
+    for (int i = 0; i < pending; i++) {
+        queue.push(delays[i & 0xffff], i);
+    }
+    std::vector<int> due;
+    size_t next_delay = 0;
+    long long events = 0;
+    for (auto _ : state) {
+        due.clear();
+        const long long now = queue.pop(due);
+        for (int value : due) {
+            queue.push(now + delays[next_delay++ & 0xffff], value);
+        }
+        events += static_cast<long long>(due.size());
+    }
+    state.SetItemsProcessed(events);
+}
+} // namespace
+
+// Acciones de 10 a 10^7 con los tres patrones de llegada
+const std::vector<int64_t> kSizes = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
+const std::vector<int64_t> kPatterns = {0, 1, 2};
+
+BENCHMARK_TEMPLATE(BM_SimulateSynchronization, MutexLock)->ArgsProduct({kSizes, kPatterns})->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SimulateSynchronization, VirtualOnly<MutexLock>)->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 19, 8), {0}});
+BENCHMARK_TEMPLATE(BM_SimulateSynchronization, Semaphore)->ArgsProduct({kSizes, kPatterns})->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SimulateSynchronization, VirtualOnly<Semaphore>)->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 19, 8), {0}});
+// Un evento por proceso y ciclo: hasta 10^6
+BENCHMARK_TEMPLATE(BM_SimulateSynchronizationEvents, MutexLock)
+    ->ArgsProduct({benchmark::CreateRange(10, 1000000, 10), kPatterns})->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SimulateSynchronizationEvents, Semaphore)
+    ->ArgsProduct({benchmark::CreateRange(10, 1000000, 10), kPatterns})->Unit(benchmark::kMicrosecond);
+// procesos x ciclos estados: hasta 10^5 acciones (unos 3·10^6 estados)
+BENCHMARK(BM_GetProcessStates)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_SimulatePartitioned, Plain<MutexLock>)
+    ->ArgsProduct({{1 << 16, 1 << 19}, {1, 2, 4, 8}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SimulatePartitioned, Plain<Semaphore>)
+    ->ArgsProduct({{1 << 16, 1 << 19}, {1, 2, 4, 8}})->UseRealTime();
+// Colas por prioridad: el orden de despertar no es el de llegada
+BENCHMARK_TEMPLATE(BM_SimulatePartitioned, PriorityMutex<PriorityProtocol::INHERITANCE>)
+    ->ArgsProduct({{1 << 16}, {1, 4}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SimulatePartitioned, PriorityMutex<PriorityProtocol::CEILING>)
+    ->ArgsProduct({{1 << 16}, {1, 4}})->UseRealTime();
+
+BENCHMARK(BM_BankerSafety)->ArgsProduct({{1 << 14, 1 << 17}, {16, 256}});
+BENCHMARK(BM_RWPolicy)->DenseRange(0, 2)->ArgName("policy");
+BENCHMARK(BM_PriorityProtocol)->DenseRange(0, 3)->ArgName("protocol");
+BENCHMARK(BM_LockCostModel)->DenseRange(0, 2)->ArgName("kind");
+BENCHMARK(BM_ReadMostly)->DenseRange(0, 2)->ArgName("mechanism");
+
+BENCHMARK_TEMPLATE(BM_ConcurrentLock, StdMutex)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentLock, FutexMutex)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentLock, StdSharedMutex)->Arg(10)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentLock, FutexSemaphore)->Arg(10)->Arg(100)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_EventQueue, HeapQueue)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {64, 1 << 20}});
+BENCHMARK_TEMPLATE(BM_EventQueue, WheelQueue)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {64, 1 << 20}});
+
+BENCHMARK_MAIN();
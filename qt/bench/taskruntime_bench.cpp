@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include "../taskruntime.h"
+#include "../scheduler.h"
+#include "workloads.h"
+#include <memory>
+
+namespace {
+
+// Microsegundos reales por unidad de tiempo de la carga
+constexpr int kTickUs = 20;
+constexpr int kSliceUs = 3 * kTickUs;   // el quantum 3 de los otros benchmarks
+constexpr int kAgingUs = 5 * kTickUs;
+
+using Clock = std::chrono::steady_clock;
+
+void spinFor(Clock::duration amount) {
+    const auto until = Clock::now() + amount;
+    while (Clock::now() < until) {
+    }
+}
+
+// Espera media que predice el simulador para lo medido: mismas llegadas y
+// ráfagas reales, en unidades de kTickUs
+double predictedWaitUs(TaskPolicy policy, std::vector<Process> processes) {
+    switch (policy) {
+    case TaskPolicy::FIFO: SchedulingAlgorithms::runFIFO(processes); break;
+    case TaskPolicy::SJF: SchedulingAlgorithms::runSJF(processes); break;
+    case TaskPolicy::ROUND_ROBIN: SchedulingAlgorithms::runRoundRobin(processes, kSliceUs / kTickUs); break;
+    case TaskPolicy::PRIORITY: SchedulingAlgorithms::runPriority(processes, true, kAgingUs / kTickUs); break;
+    }
+    return SchedulingAlgorithms::calculateAverageWaitingTime(processes) * kTickUs;
+}
+
+// La carga compartida como tareas reales en un solo trabajador (el simulador
+// modela una CPU): cada proceso se envía en su arrival_time y gira burst_time
+// unidades. Se comparan los retrasos en cola medidos con los que predice
+// SchedulingAlgorithms sobre toProcesses().
+// range(0) = tareas, range(1) = ArrivalPattern, range(2) = TaskPolicy
+void BM_TaskRuntime(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const auto pattern = static_cast<workloads::ArrivalPattern>(state.range(1));
+    const auto policy = static_cast<TaskPolicy>(state.range(2));
+    const auto processes = workloads::makeProcesses(count, pattern);
+    const auto tick = std::chrono::microseconds(kTickUs);
+
+    TaskRuntimeOptions options;
+    options.policy = policy;
+    options.workers = 1;
+    options.slice_us = kSliceUs;
+    options.aging = true;
+    options.aging_interval_us = kAgingUs;
+
+    double measured_avg = 0, measured_p99 = 0, predicted_avg = 0, throughput = 0;
+    for (auto _ : state) {
+        TaskRuntime runtime(options);
+        const auto origin = Clock::now();
+        for (const auto& process : processes) {
+            std::this_thread::sleep_until(origin + tick * process.arrival_time);
+            TaskHints hints;
+            hints.name = process.pid;
+            hints.burst_hint_us = static_cast<long long>(process.burst_time) * kTickUs;
+            hints.priority = process.priority;
+            const auto burst = tick * process.burst_time;
+            if (policy == TaskPolicy::ROUND_ROBIN) {
+                // Gira hasta acabar su ráfaga o su turno
+                auto left = std::make_shared<Clock::duration>(burst);
+                runtime.submitCooperative([left](TaskContext& context) {
+                    while (*left > Clock::duration::zero() && !context.shouldYield()) {
+                        const auto step = std::min<Clock::duration>(*left, std::chrono::microseconds(5));
+                        spinFor(step);
+                        *left -= step;
+                    }
+                    return *left <= Clock::duration::zero();
+                }, hints);
+            } else {
+                runtime.submit([burst]() { spinFor(burst); }, hints);
+            }
+        }
+        runtime.waitIdle();
+
+        const TaskRuntimeStats stats = runtime.stats();
+        measured_avg += stats.avg_queue_delay_us;
+        measured_p99 += stats.p99_queue_delay_us;
+        throughput += stats.throughput_per_s;
+        predicted_avg += predictedWaitUs(policy, runtime.toProcesses(kTickUs));
+    }
+    const double runs = static_cast<double>(state.iterations());
+    state.counters["queue_delay_us"] = measured_avg / runs;
+    state.counters["queue_delay_p99_us"] = measured_p99 / runs;
+    state.counters["predicted_wait_us"] = predicted_avg / runs;
+    state.counters["tasks_per_s"] = throughput / runs;
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+// Cada iteración dura lo que la carga en tiempo real (~count · 5,5 · kTickUs)
+BENCHMARK(BM_TaskRuntime)
+    ->ArgNames({"n", "arrivals", "policy"})
+    ->ArgsProduct({{100, 1000}, {0, 1, 2}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
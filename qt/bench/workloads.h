@@ -0,0 +1,165 @@
+#ifndef BENCH_WORKLOADS_H
+#define BENCH_WORKLOADS_H
+
+#include "../utils.h"
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <set>
+
+// Generadores de cargas sintéticas reproducibles para los benchmarks
+namespace workloads {
+
+inline std::vector<Resource> makeResources(int count, int slots) {
+    std::vector<Resource> resources;
+    for (int r = 0; r < count; r++) {
+        resources.push_back(Resource(QString("R%1").arg(r), slots));
+    }
+    return resources;
+}
+
+// `count` acciones READ/WRITE repartidas entre `pids` procesos y `resources`
+// recursos, con llegadas uniformes en [0, cycle_span)
+inline std::vector<Action> makeActions(int count, int pids, int resources, int cycle_span, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pid(0, pids - 1);
+    std::uniform_int_distribution<int> resource(0, resources - 1);
+    std::uniform_int_distribution<int> cycle(0, cycle_span - 1);
+    std::bernoulli_distribution write(0.3);
+
+    std::vector<Action> actions;
+    actions.reserve(count);
+    for (int i = 0; i < count; i++) {
+        actions.push_back(Action(QString("P%1").arg(pid(rng)), write(rng) ? "WRITE" : "READ",
+                                 QString("R%1").arg(resource(rng)), cycle(rng)));
+    }
+    return actions;
+}
+
+// Como makeActions, pero en `clusters` grupos independientes: los procesos de
+// un grupo solo usan los recursos de ese grupo
+inline std::vector<Action> makeClusteredActions(int count, int clusters, int pids, int resources,
+                                                int cycle_span, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> cluster(0, clusters - 1);
+    std::uniform_int_distribution<int> pid(0, pids - 1);
+    std::uniform_int_distribution<int> resource(0, resources - 1);
+    std::uniform_int_distribution<int> cycle(0, cycle_span - 1);
+    std::bernoulli_distribution write(0.3);
+
+    std::vector<Action> actions;
+    actions.reserve(count);
+    for (int i = 0; i < count; i++) {
+        int c = cluster(rng);
+        actions.push_back(Action(QString("C%1P%2").arg(c).arg(pid(rng)), write(rng) ? "WRITE" : "READ",
+                                 QString("C%1R%2").arg(c).arg(resource(rng)), cycle(rng)));
+    }
+    return actions;
+}
+
+// `jobs` trabajos de un solo uso: cada uno toma un recurso durante `hold`
+// ciclos y, un ciclo después, otro de índice mayor (orden fijo de adquisición)
+inline std::vector<Action> makeNestedActions(int jobs, int resources, int cycle_span, int hold,
+                                             unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> outer(0, resources - 2);
+    std::uniform_int_distribution<int> cycle(0, cycle_span - 1);
+
+    std::vector<Action> actions;
+    actions.reserve(2 * jobs);
+    for (int j = 0; j < jobs; j++) {
+        const int first = outer(rng);
+        const int second = std::uniform_int_distribution<int>(first + 1, resources - 1)(rng);
+        const int start = cycle(rng);
+        const QString pid = QString("J%1").arg(j);
+        actions.push_back(Action(pid, "WRITE", QString("R%1").arg(first), start, hold));
+        actions.push_back(Action(pid, "WRITE", QString("R%1").arg(second), start + 1, 1));
+    }
+    return actions;
+}
+
+// Cómo se reparten las llegadas en el tiempo
+enum class ArrivalPattern {
+    UNIFORM, // uniformes en todo el intervalo
+    POISSON, // huecos exponenciales (proceso de Poisson)
+    BURSTY   // grupos de kBurstSize que llegan en el mismo instante
+};
+
+constexpr int kBurstSize = 1000;
+
+// `count` instantes no decrecientes con un hueco medio de `mean_gap`
+inline std::vector<int> makeArrivals(int count, ArrivalPattern pattern, double mean_gap, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::vector<int> arrivals(count);
+    const double span = mean_gap * count;
+    switch (pattern) {
+    case ArrivalPattern::UNIFORM: {
+        std::uniform_real_distribution<double> at(0.0, span);
+        for (auto& arrival : arrivals) arrival = static_cast<int>(at(rng));
+        std::sort(arrivals.begin(), arrivals.end());
+        break;
+    }
+    case ArrivalPattern::POISSON: {
+        std::exponential_distribution<double> gap(1.0 / mean_gap);
+        double now = 0.0;
+        for (auto& arrival : arrivals) {
+            arrival = static_cast<int>(now);
+            now += gap(rng);
+        }
+        break;
+    }
+    case ArrivalPattern::BURSTY:
+        for (int i = 0; i < count; i++) {
+            arrivals[i] = static_cast<int>((i / kBurstSize) * kBurstSize * mean_gap);
+        }
+        break;
+    }
+    return arrivals;
+}
+
+// Procesos en orden de llegada con ráfagas de 1 a 10 y prioridades de 1 a 5:
+// el hueco medio iguala la ráfaga media, así que la CPU va a carga ~1
+inline std::vector<Process> makeProcesses(int count, ArrivalPattern pattern, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> burst(1, 10);
+    std::uniform_int_distribution<int> priority(1, 5);
+    const std::vector<int> arrivals = makeArrivals(count, pattern, 5.5, seed);
+
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const int bt = burst(rng);
+        processes.push_back(Process(QString("P%1").arg(i), bt, arrivals[i], priority(rng), -1, -1, -1, -1, Qt::white));
+    }
+    return processes;
+}
+
+// Reparte los ciclos de `actions` según `pattern` dentro de [0, cycle_span)
+inline void shapeArrivals(std::vector<Action>& actions, ArrivalPattern pattern, int cycle_span, unsigned seed = 42) {
+    if (actions.empty()) return;
+    const std::vector<int> cycles = makeArrivals(static_cast<int>(actions.size()), pattern,
+                                                 static_cast<double>(cycle_span) / actions.size(), seed);
+    for (size_t i = 0; i < actions.size(); i++) {
+        actions[i].cycle = cycles[i];
+    }
+}
+
+inline std::vector<Process> makeSyncProcesses(const std::vector<Action>& actions) {
+    std::set<QString> pids;
+    for (const auto& action : actions) {
+        pids.insert(action.pid);
+    }
+    std::vector<Process> processes;
+    for (const auto& pid : pids) {
+        Process p;
+        p.pid = pid;
+        p.burst_time = 1;
+        p.priority = 1;
+        processes.push_back(p);
+    }
+    return processes;
+}
+
+} // namespace workloads
+
+#endif
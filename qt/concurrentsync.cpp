@@ -0,0 +1,345 @@
+#include "concurrentsync.h"
+#include <QDebug>
+#include <chrono>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kWriterBit = 1u << 31;
+constexpr uint32_t kReaderMask = kWriterBit - 1;
+constexpr int kSpins = 64; // vueltas antes de dormir: las secciones cortas se liberan enseguida
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+    // EAGAIN si ya cambió; EINTR y despertares espurios los absorbe el bucle de quien llama
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>& word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Nanosegundos desde el primer uso; pequeños para que las sumas de hold_ns no desborden
+int64_t nowNs() {
+    static const auto base = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - base).count();
+}
+
+// hold_ns guarda Σ liberaciones − Σ adquisiciones; las retenciones en curso suman hasta ahora
+template<class Slot>
+LockStats snapshot(const Slot& slot, uint32_t holders) {
+    LockStats stats;
+    stats.acquisitions = slot.acquisitions.load(std::memory_order_relaxed);
+    stats.contended = slot.contended.load(std::memory_order_relaxed);
+    stats.wait_ns = slot.wait_ns.load(std::memory_order_relaxed);
+    int64_t hold = slot.hold_ns.load(std::memory_order_relaxed) + static_cast<int64_t>(holders) * nowNs();
+    stats.hold_ns = hold > 0 ? static_cast<uint64_t>(hold) : 0;
+    return stats;
+}
+
+void accumulate(LockStats& total, const LockStats& stats) {
+    total.acquisitions += stats.acquisitions;
+    total.contended += stats.contended;
+    total.wait_ns += stats.wait_ns;
+    total.hold_ns += stats.hold_ns;
+}
+
+} // namespace
+
+ConcurrentMutexLock::ConcurrentMutexLock(const std::vector<Resource>& res) : resources(res) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
+    resetResources();
+}
+
+ConcurrentMutexLock::Slot& ConcurrentMutexLock::ensureSlot(int resource) {
+    while (resource >= static_cast<int>(slots.size())) {
+        slots.push_back(std::make_unique<Slot>());
+    }
+    return *slots[resource];
+}
+
+bool ConcurrentMutexLock::tryAcquire(int resource, int pid, AccessType type) {
+    Slot& slot = ensureSlot(resource);
+    uint32_t expected = 0;
+    if (!slot.state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return false;
+    }
+    slot.owner.store(pid, std::memory_order_relaxed);
+    slot.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    slot.hold_ns.fetch_sub(nowNs(), std::memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentMutexLock::acquire(int resource, int pid, AccessType type) {
+    if (tryAcquire(resource, pid, type)) return true;
+
+    Slot& slot = *slots[resource];
+    const int64_t asked = nowNs();
+    // Mutex de tres estados (Drepper, "Futexes Are Tricky"): quien duerme deja
+    // el estado en 2 para que la liberación sepa que hay que despertar
+    // compare_exchange_weak puede fallar en falso (LL/SC en ARM o POWER) y
+    // dejar state == 0: solo cuenta como tomado si el CAS tuvo éxito
+    bool acquired = false;
+    for (int spin = 0; spin < kSpins; spin++) {
+        uint32_t state = 0;
+        if (slot.state.compare_exchange_weak(state, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            acquired = true;
+            break;
+        }
+        if (state == 2) break;
+        cpuRelax();
+    }
+    if (!acquired) {
+        uint32_t state = slot.state.exchange(2, std::memory_order_acquire);
+        while (state != 0) {
+            futexWait(slot.state, 2);
+            state = slot.state.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    const int64_t got = nowNs();
+    slot.owner.store(pid, std::memory_order_relaxed);
+    slot.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    slot.contended.fetch_add(1, std::memory_order_relaxed);
+    slot.wait_ns.fetch_add(static_cast<uint64_t>(got - asked), std::memory_order_relaxed);
+    slot.hold_ns.fetch_sub(got, std::memory_order_relaxed);
+    return true;
+}
+
+void ConcurrentMutexLock::release(int resource, int pid) {
+    if (resource >= static_cast<int>(slots.size())) {
+        return;
+    }
+    Slot& slot = *slots[resource];
+    if (slot.owner.load(std::memory_order_relaxed) != pid) {
+        return;
+    }
+    slot.owner.store(-1, std::memory_order_relaxed);
+    slot.hold_ns.fetch_add(nowNs(), std::memory_order_relaxed);
+    if (slot.state.fetch_sub(1, std::memory_order_release) != 1) {
+        slot.state.store(0, std::memory_order_release);
+        futexWake(slot.state, 1);
+    }
+}
+
+bool ConcurrentMutexLock::isAvailable(int resource) const {
+    return resource >= static_cast<int>(slots.size())
+        || slots[resource]->state.load(std::memory_order_relaxed) == 0;
+}
+
+void ConcurrentMutexLock::resetResources() {
+    slots.clear();
+    for (int r = 0; r < resource_names.size(); r++) {
+        ensureSlot(r);
+    }
+}
+
+std::unique_ptr<SynchronizationMechanism> ConcurrentMutexLock::clone() const {
+    auto copy = std::make_unique<ConcurrentMutexLock>(resources);
+    copy->resource_names = resource_names;
+    copy->process_names = process_names;
+    copy->resetResources();
+    return copy;
+}
+
+LockStats ConcurrentMutexLock::stats(int resource) const {
+    if (resource >= static_cast<int>(slots.size())) {
+        return LockStats();
+    }
+    const Slot& slot = *slots[resource];
+    return snapshot(slot, slot.state.load(std::memory_order_relaxed) != 0 ? 1 : 0);
+}
+
+LockStats ConcurrentMutexLock::totalStats() const {
+    LockStats total;
+    for (int r = 0; r < static_cast<int>(slots.size()); r++) {
+        accumulate(total, stats(r));
+    }
+    return total;
+}
+
+ConcurrentSemaphore::ConcurrentSemaphore(const std::vector<Resource>& res, RWPolicy rw_policy)
+    : resources(res), policy(rw_policy) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
+    if (policy == RWPolicy::PHASE_FAIR) {
+        qDebug() << "ConcurrentSemaphore: PHASE_FAIR not supported, using WRITER_PREFERENCE";
+        policy = RWPolicy::WRITER_PREFERENCE;
+    }
+    resetResources();
+}
+
+ConcurrentSemaphore::Slot& ConcurrentSemaphore::ensureSlot(int resource) {
+    // Recurso no declarado: sin cupos de lectura, como Semaphore
+    while (resource >= static_cast<int>(slots.size())) {
+        slots.push_back(std::make_unique<Slot>());
+    }
+    return *slots[resource];
+}
+
+bool ConcurrentSemaphore::tryEnter(Slot& slot, AccessType type) const {
+    if (type == AccessType::WRITE) {
+        uint32_t expected = 0;
+        return slot.state.compare_exchange_strong(expected, kWriterBit, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    if (type != AccessType::READ) {
+        return false;
+    }
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    while (!(state & kWriterBit) && (state & kReaderMask) < slot.max_readers) {
+        // Con escritores esperando, los lectores nuevos no se adelantan
+        if (policy == RWPolicy::WRITER_PREFERENCE && slot.waiting_writers.load(std::memory_order_relaxed) > 0) {
+            return false;
+        }
+        if (slot.state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConcurrentSemaphore::tryAcquire(int resource, int pid, AccessType type) {
+    Slot& slot = ensureSlot(resource);
+    if (!tryEnter(slot, type)) {
+        return false;
+    }
+    if (type == AccessType::WRITE) {
+        slot.writer.store(pid, std::memory_order_relaxed);
+    }
+    slot.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    slot.hold_ns.fetch_sub(nowNs(), std::memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentSemaphore::acquire(int resource, int pid, AccessType type) {
+    if (tryAcquire(resource, pid, type)) return true;
+    Slot& slot = *slots[resource];
+    if (type == AccessType::OTHER || (type == AccessType::READ && slot.max_readers == 0)) {
+        qDebug() << "Resource" << resource_names.name(resource) << "can never be acquired for this access";
+        return false;
+    }
+
+    const int64_t asked = nowNs();
+    if (type == AccessType::WRITE) {
+        slot.waiting_writers.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (;;) {
+        bool entered = false;
+        for (int spin = 0; spin < kSpins && !entered; spin++) {
+            entered = tryEnter(slot, type);
+            if (!entered) cpuRelax();
+        }
+        if (entered) break;
+        // Anunciarse antes de releer el estado: la liberación mira `sleepers`
+        // después de cambiar `state`, así que no se pierde el despertar
+        slot.sleepers.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t seen = slot.state.load(std::memory_order_seq_cst);
+        const bool blocked = type == AccessType::WRITE
+            ? seen != 0
+            : (seen & kWriterBit) || (seen & kReaderMask) >= slot.max_readers
+              || (policy == RWPolicy::WRITER_PREFERENCE && slot.waiting_writers.load(std::memory_order_relaxed) > 0);
+        if (blocked) {
+            futexWait(slot.state, seen);
+        }
+        slot.sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (type == AccessType::WRITE) {
+        slot.waiting_writers.fetch_sub(1, std::memory_order_relaxed);
+        slot.writer.store(pid, std::memory_order_relaxed);
+    }
+
+    const int64_t got = nowNs();
+    slot.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    slot.contended.fetch_add(1, std::memory_order_relaxed);
+    slot.wait_ns.fetch_add(static_cast<uint64_t>(got - asked), std::memory_order_relaxed);
+    slot.hold_ns.fetch_sub(got, std::memory_order_relaxed);
+    return true;
+}
+
+void ConcurrentSemaphore::release(int resource, int pid) {
+    if (resource >= static_cast<int>(slots.size())) {
+        return;
+    }
+    Slot& slot = *slots[resource];
+    if (slot.writer.load(std::memory_order_relaxed) == pid) {
+        slot.writer.store(-1, std::memory_order_relaxed);
+        slot.state.store(0, std::memory_order_seq_cst);
+    } else {
+        // Lector: solo se descuenta mientras haya lectores dentro. Una
+        // liberación doble o de quien no leía no puede bajar de cero e
+        // invadir el bit del escritor; se rechaza sin tocar el estado
+        uint32_t state = slot.state.load(std::memory_order_relaxed);
+        do {
+            if ((state & kWriterBit) || (state & kReaderMask) == 0) {
+                qDebug() << "ConcurrentSemaphore: process" << pid << "released resource" << resource
+                         << "without holding it; ignored";
+                return;
+            }
+        } while (!slot.state.compare_exchange_weak(state, state - 1, std::memory_order_seq_cst, std::memory_order_relaxed));
+    }
+    slot.hold_ns.fetch_add(nowNs(), std::memory_order_relaxed);
+    // Se despierta a todos: pueden entrar varios lectores a la vez
+    if (slot.sleepers.load(std::memory_order_seq_cst) > 0) {
+        futexWake(slot.state, INT_MAX);
+    }
+}
+
+bool ConcurrentSemaphore::isAvailable(int resource) const {
+    if (resource >= static_cast<int>(slots.size())) {
+        return false;
+    }
+    const Slot& slot = *slots[resource];
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    return !(state & kWriterBit) && (state & kReaderMask) < slot.max_readers;
+}
+
+void ConcurrentSemaphore::resetResources() {
+    slots.clear();
+    for (int r = 0; r < resource_names.size(); r++) {
+        ensureSlot(r);
+    }
+    for (const auto& resource : resources) {
+        int id = resource_names.find(resource.name);
+        if (id >= 0) {
+            slots[id]->max_readers = static_cast<uint32_t>(std::max(resource.count, 0));
+        }
+    }
+}
+
+std::unique_ptr<SynchronizationMechanism> ConcurrentSemaphore::clone() const {
+    auto copy = std::make_unique<ConcurrentSemaphore>(resources, policy);
+    copy->resource_names = resource_names;
+    copy->process_names = process_names;
+    copy->resetResources();
+    return copy;
+}
+
+LockStats ConcurrentSemaphore::stats(int resource) const {
+    if (resource >= static_cast<int>(slots.size())) {
+        return LockStats();
+    }
+    const Slot& slot = *slots[resource];
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    return snapshot(slot, (state & kReaderMask) + ((state & kWriterBit) ? 1 : 0));
+}
+
+LockStats ConcurrentSemaphore::totalStats() const {
+    LockStats total;
+    for (int r = 0; r < static_cast<int>(slots.size()); r++) {
+        accumulate(total, stats(r));
+    }
+    return total;
+}
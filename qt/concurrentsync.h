@@ -0,0 +1,100 @@
+#ifndef CONCURRENTSYNC_H
+#define CONCURRENTSYNC_H
+
+#include "synchronizer.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Contadores de un recurso; una foto, no exacta mientras otros hilos lo usan
+struct LockStats {
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;   // adquisiciones que no salieron al primer intento
+    uint64_t wait_ns = 0;     // tiempo esperando en esas adquisiciones
+    uint64_t hold_ns = 0;     // tiempo retenido, incluidas las retenciones en curso
+};
+
+// Versiones concurrentes de MutexLock y Semaphore sobre futex de Linux. La
+// interfaz por id es segura entre hilos siempre que los ids ya existan: los
+// recursos se registran al construir (o con resourceId antes de repartir el
+// objeto); un id nuevo amplía las tablas y eso solo vale en un único hilo,
+// como hace el simulador. La interfaz por nombre interna y no es concurrente.
+class ConcurrentMutexLock final : public SynchronizationMechanism {
+public:
+    explicit ConcurrentMutexLock(const std::vector<Resource>& res);
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    // Bloquea hasta obtenerlo: unas vueltas y después duerme en el futex
+    bool acquire(int resource, int pid, AccessType type);
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
+    void resetResources() override;
+    std::unique_ptr<SynchronizationMechanism> clone() const override;
+
+    LockStats stats(int resource) const;
+    LockStats totalStats() const;
+
+    // Una línea de caché por recurso para que no se estorben entre sí
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> state{0};   // 0 libre, 1 ocupado, 2 ocupado con durmientes
+        std::atomic<int> owner{-1};
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contended{0};
+        std::atomic<uint64_t> wait_ns{0};
+        std::atomic<int64_t> hold_ns{0};  // suma de liberaciones menos suma de adquisiciones
+    };
+
+private:
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<Resource> resources;
+
+    Slot& ensureSlot(int resource);
+};
+
+// Lectores compartidos hasta `count` del recurso y escritor exclusivo, como
+// Semaphore. PHASE_FAIR no tiene versión concurrente y se trata como
+// WRITER_PREFERENCE. Los lectores no se registran por proceso: release
+// rechaza la de un lector si no hay ninguno dentro, pero no sabe cuál lee.
+class ConcurrentSemaphore final : public SynchronizationMechanism {
+public:
+    ConcurrentSemaphore(const std::vector<Resource>& res, RWPolicy rw_policy = RWPolicy::READER_PREFERENCE);
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    // false si ese acceso nunca podría concederse (lectura sin cupos)
+    bool acquire(int resource, int pid, AccessType type);
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
+    void resetResources() override;
+    std::unique_ptr<SynchronizationMechanism> clone() const override;
+    RWPolicy rwPolicy() const { return policy; }
+
+    LockStats stats(int resource) const;
+    LockStats totalStats() const;
+
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> state{0};            // lectores dentro; bit alto: escritor dentro
+        std::atomic<uint32_t> waiting_writers{0};
+        std::atomic<uint32_t> sleepers{0};         // hilos dormidos en el futex de `state`
+        std::atomic<int> writer{-1};
+        uint32_t max_readers = 0;
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contended{0};
+        std::atomic<uint64_t> wait_ns{0};
+        std::atomic<int64_t> hold_ns{0};
+    };
+
+private:
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<Resource> resources;
+    RWPolicy policy;
+
+    Slot& ensureSlot(int resource);
+    bool tryEnter(Slot& slot, AccessType type) const;
+};
+
+#endif
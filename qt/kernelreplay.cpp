@@ -0,0 +1,274 @@
+#include "kernelreplay.h"
+#include "scheduler.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+// Lo que cada trabajador deja en memoria compartida con el padre
+struct WorkerTimes {
+    long long start_ns;
+    long long finish_ns;
+    long long rr_interval_ns; // quantum que el kernel da a este trabajador
+    int policy_applied;
+    int affinity_applied;
+    int done;
+};
+
+long long monotonicNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+long long cpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void sleepUntilNs(long long deadline) {
+    timespec ts;
+    ts.tv_sec = deadline / 1000000000LL;
+    ts.tv_nsec = deadline % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+
+int kernelPolicy(KernelPolicy policy) {
+    switch (policy) {
+    case KernelPolicy::FIFO: return SCHED_FIFO;
+    case KernelPolicy::RR: return SCHED_RR;
+    case KernelPolicy::OTHER: break;
+    }
+    return SCHED_OTHER;
+}
+
+// Hijo: aplica CPUs y política, gira hasta gastar su ráfaga y sale sin
+// pasar por los destructores del padre
+[[noreturn]] void runWorker(WorkerTimes& times, long long burst_ns, long long origin,
+                            const KernelReplayOptions& options) {
+    bool pinned = true;
+    if (!options.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : options.cpus) CPU_SET(cpu, &set);
+        pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+    times.affinity_applied = pinned ? 1 : 0;
+    bool applied = true;
+    if (options.policy != KernelPolicy::OTHER) {
+        sched_param param{};
+        param.sched_priority = options.rt_priority;
+        applied = sched_setscheduler(0, kernelPolicy(options.policy), &param) == 0;
+    }
+    times.policy_applied = applied ? 1 : 0;
+    timespec interval;
+    if (sched_rr_get_interval(0, &interval) == 0) {
+        times.rr_interval_ns = interval.tv_sec * 1000000000LL + interval.tv_nsec;
+    }
+    times.start_ns = monotonicNs() - origin;
+
+    const long long cpu_start = cpuNs();
+    volatile unsigned long long spin = 0;
+    while (cpuNs() - cpu_start < burst_ns) {
+        for (int i = 0; i < 1000; i++) spin = spin + 1;
+    }
+    times.finish_ns = monotonicNs() - origin;
+    times.done = 1;
+    _exit(0);
+}
+
+} // namespace
+
+KernelReplayResult KernelReplay::run(const std::vector<Process>& processes, const KernelReplayOptions& options) {
+    KernelReplayResult result;
+    const int count = static_cast<int>(processes.size());
+    if (count == 0) return result;
+
+    cpu_set_t allowed;
+    const bool known = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    for (int cpu : options.cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE || (known && !CPU_ISSET(cpu, &allowed))) {
+            result.error = QString("la CPU %1 no existe o no está permitida").arg(cpu);
+            qDebug() << "Kernel replay refused:" << result.error;
+            return result;
+        }
+    }
+    result.samples.resize(count);
+
+    const long long tick_ns = std::max(options.tick_us, 1) * 1000LL;
+    void* memory = mmap(nullptr, sizeof(WorkerTimes) * count, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        qDebug() << "Cannot map shared memory for" << count << "workers";
+        result.error = "no se pudo reservar memoria compartida para los trabajadores";
+        return result;
+    }
+    WorkerTimes* times = static_cast<WorkerTimes*>(memory);
+    std::fill(times, times + count, WorkerTimes{-1, -1, 0, 0, 0, 0});
+
+    // El padre, fuera de las CPUs de los trabajadores: si no, uno de tiempo
+    // real no le dejaría crear el siguiente
+    cpu_set_t original;
+    const bool restore_affinity = sched_getaffinity(0, sizeof(original), &original) == 0;
+    if (restore_affinity && !options.cpus.empty()) {
+        cpu_set_t rest = original;
+        for (int cpu : options.cpus) CPU_CLR(cpu, &rest);
+        if (CPU_COUNT(&rest) > 0) {
+            sched_setaffinity(0, sizeof(rest), &rest);
+        } else if (options.policy != KernelPolicy::OTHER) {
+            qDebug() << "No CPU left for the replay driver; real-time workers may delay later arrivals";
+        }
+    }
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return processes[a].arrival_time < processes[b].arrival_time;
+    });
+
+    long long total_burst = 0;
+    for (const auto& process : processes) {
+        total_burst += std::max(process.burst_time, 0);
+    }
+    const long long origin = monotonicNs() + 50000000LL; // margen antes del instante 0
+    std::vector<pid_t> children(count, -1);
+    std::vector<long long> created(count, 0);
+    for (int i : order) {
+        sleepUntilNs(origin + processes[i].arrival_time * tick_ns);
+        created[i] = monotonicNs() - origin;
+        pid_t child = fork();
+        if (child == 0) {
+            runWorker(times[i], std::max(processes[i].burst_time, 0) * tick_ns, origin, options);
+        }
+        if (child < 0) {
+            qDebug() << "fork failed for process" << processes[i].pid;
+            continue;
+        }
+        children[i] = child;
+    }
+
+    // Plazo generoso: cuatro veces el trabajo total tras la última llegada
+    const long long last_arrival = processes[order.back()].arrival_time * tick_ns;
+    const long long deadline = origin + last_arrival + 4 * total_burst * tick_ns + 2000000000LL;
+    int running = static_cast<int>(std::count_if(children.begin(), children.end(), [](pid_t p) { return p > 0; }));
+    while (running > 0) {
+        pid_t finished = waitpid(-1, nullptr, WNOHANG);
+        if (finished > 0) {
+            running--;
+            continue;
+        }
+        if (finished < 0 && errno == ECHILD) break;
+        if (monotonicNs() > deadline) {
+            for (int i = 0; i < count; i++) {
+                if (children[i] > 0 && !times[i].done) {
+                    kill(children[i], SIGKILL);
+                    result.killed++;
+                }
+            }
+            while (waitpid(-1, nullptr, 0) > 0) {
+            }
+            break;
+        }
+        usleep(1000);
+    }
+    if (restore_affinity) {
+        sched_setaffinity(0, sizeof(original), &original);
+    }
+
+    int finished_count = 0;
+    for (int i = 0; i < count; i++) {
+        KernelReplaySample& sample = result.samples[i];
+        sample.pid = processes[i].pid;
+        sample.arrival = static_cast<double>(created[i]) / tick_ns;
+        sample.policy_applied = times[i].policy_applied != 0;
+        result.max_fork_lag = std::max(result.max_fork_lag, sample.arrival - processes[i].arrival_time);
+        if (children[i] > 0 && !sample.policy_applied && times[i].start_ns >= 0) {
+            result.policy_fallbacks++;
+        }
+        if (children[i] > 0 && !times[i].affinity_applied && times[i].start_ns >= 0) {
+            result.affinity_failures++;
+        }
+        if (!times[i].done) continue;
+        if (times[i].rr_interval_ns > 0 && result.rr_quantum == 0) {
+            result.rr_quantum = static_cast<double>(times[i].rr_interval_ns) / tick_ns;
+        }
+        sample.start = static_cast<double>(times[i].start_ns) / tick_ns;
+        sample.finish = static_cast<double>(times[i].finish_ns) / tick_ns;
+        sample.turnaround = sample.finish - sample.arrival;
+        sample.waiting = std::max(0.0, sample.turnaround - processes[i].burst_time);
+        result.avg_waiting += sample.waiting;
+        result.avg_turnaround += sample.turnaround;
+        finished_count++;
+    }
+    if (finished_count > 0) {
+        result.avg_waiting /= finished_count;
+        result.avg_turnaround /= finished_count;
+    }
+    if (result.policy_fallbacks > 0) {
+        qDebug() << result.policy_fallbacks << "workers could not switch policy (needs CAP_SYS_NICE or RLIMIT_RTPRIO)";
+    }
+    munmap(memory, sizeof(WorkerTimes) * count);
+    return result;
+}
+
+std::vector<KernelModelComparison> KernelReplay::compare(const std::vector<Process>& processes,
+                                                         const KernelReplayResult& measured,
+                                                         KernelPolicy policy, int quantum) {
+    std::map<QString, const KernelReplaySample*> by_pid;
+    for (const auto& sample : measured.samples) {
+        if (sample.finish >= 0) by_pid[sample.pid] = &sample;
+    }
+
+    if (policy == KernelPolicy::RR && measured.rr_quantum > 0) {
+        quantum = static_cast<int>(std::lround(measured.rr_quantum));
+    }
+    quantum = std::max(quantum, 1);
+
+    std::vector<KernelModelComparison> comparisons;
+    for (int algorithm = 0; algorithm < 2; algorithm++) {
+        std::vector<Process> predicted = processes;
+        KernelModelComparison comparison;
+        if (algorithm == 0) {
+            SchedulingAlgorithms::runFIFO(predicted);
+            comparison.algorithm = "FIFO";
+        } else {
+            SchedulingAlgorithms::runRoundRobin(predicted, quantum);
+            comparison.algorithm = QString("Round Robin (q=%1)").arg(quantum);
+        }
+        comparison.avg_waiting = SchedulingAlgorithms::calculateAverageWaitingTime(predicted);
+
+        int matched = 0;
+        for (const auto& process : predicted) {
+            // El simulador no rellena turnaround_time: fin − llegada
+            const int turnaround = process.finish_time - process.arrival_time;
+            comparison.avg_turnaround += turnaround;
+            auto found = by_pid.find(process.pid);
+            if (found == by_pid.end() || process.waiting_time < 0) continue;
+            const double waiting_error = std::fabs(found->second->waiting - process.waiting_time);
+            comparison.waiting_mean_abs_error += waiting_error;
+            comparison.waiting_max_abs_error = std::max(comparison.waiting_max_abs_error, waiting_error);
+            comparison.turnaround_mean_abs_error += std::fabs(found->second->turnaround - turnaround);
+            matched++;
+        }
+        if (!predicted.empty()) {
+            comparison.avg_turnaround /= predicted.size();
+        }
+        if (matched > 0) {
+            comparison.waiting_mean_abs_error /= matched;
+            comparison.turnaround_mean_abs_error /= matched;
+        }
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
@@ -0,0 +1,73 @@
+#ifndef KERNELREPLAY_H
+#define KERNELREPLAY_H
+
+#include "utils.h"
+#include <QString>
+#include <vector>
+
+// Política del kernel con que corren los trabajadores
+enum class KernelPolicy {
+    OTHER, // SCHED_OTHER (CFS / EEVDF)
+    FIFO,  // SCHED_FIFO, misma prioridad de tiempo real para todos
+    RR     // SCHED_RR, ídem, con el quantum del kernel
+};
+
+struct KernelReplayOptions {
+    KernelPolicy policy = KernelPolicy::OTHER;
+    int tick_us = 10000;          // microsegundos reales por unidad de tiempo del simulador
+    std::vector<int> cpus = {0};  // CPUs de los trabajadores; vacío = sin fijar
+    int rt_priority = 10;         // sched_priority para FIFO/RR
+};
+
+// Tiempos medidos de un proceso, en unidades del simulador (pueden ser fraccionarias)
+struct KernelReplaySample {
+    QString pid;
+    double arrival = 0;       // cuándo se creó de verdad el trabajador
+    double start = -1;        // primera instrucción ya con política y CPUs aplicadas
+    double finish = -1;
+    double waiting = -1;      // turnaround − ráfaga
+    double turnaround = -1;
+    bool policy_applied = false;
+};
+
+struct KernelReplayResult {
+    std::vector<KernelReplaySample> samples; // mismo orden que los procesos de entrada
+    int policy_fallbacks = 0;  // trabajadores que siguieron en SCHED_OTHER por falta de permisos
+    int affinity_failures = 0; // trabajadores que no se pudieron fijar a `cpus`
+    int killed = 0;            // no terminaron antes del plazo
+    double max_fork_lag = 0;   // retraso máximo de la creación respecto a arrival_time
+    double rr_quantum = 0;     // quantum de SCHED_RR del kernel, en unidades
+    double avg_waiting = 0;
+    double avg_turnaround = 0;
+    QString error;             // por qué no se ejecutó; vacío si se ejecutó
+};
+
+// Predicción de un algoritmo del simulador frente a lo medido
+struct KernelModelComparison {
+    QString algorithm;
+    double avg_waiting = 0;          // predichos
+    double avg_turnaround = 0;
+    double waiting_mean_abs_error = 0;
+    double waiting_max_abs_error = 0;
+    double turnaround_mean_abs_error = 0;
+};
+
+class KernelReplay {
+public:
+    // Crea con fork() un trabajador por proceso en su arrival_time, que gira
+    // hasta gastar burst_time de CPU. Bloquea hasta que terminan todos (o se
+    // agota el plazo y se matan): desde la interfaz hay que llamarlo en otro
+    // hilo. El hilo que llama se aparta de `cpus` para poder seguir creando
+    // trabajadores aunque estos sean de tiempo real. Una CPU que no existe o
+    // que el proceso no tiene permitida devuelve `error` sin crear ninguno.
+    static KernelReplayResult run(const std::vector<Process>& processes, const KernelReplayOptions& options);
+
+    // runFIFO y runRoundRobin sobre los mismos procesos; con SCHED_RR se usa
+    // el quantum del kernel en vez de `quantum`. El simulador modela una
+    // sola CPU: con varias en `cpus` el error incluye esa diferencia.
+    static std::vector<KernelModelComparison> compare(const std::vector<Process>& processes,
+                                                      const KernelReplayResult& measured,
+                                                      KernelPolicy policy, int quantum);
+};
+
+#endif
@@ -4,6 +4,36 @@
 #include <QDebug>
 #include <QStringList>
 #include <QColor>
+#include <algorithm>
+
+static const QStringList& processColorPalette() {
+    static const QStringList colors = {"#FF6B6B", "#4ECDC4", "#45B7D1", "#96CEB4", "#FFEAA7", 
+                                       "#DDA0DD", "#F0E68C", "#FFB6C1", "#87CEEB", "#98FB98"};
+    return colors;
+}
+
+QColor processColor(int index) {
+    const QStringList& colors = processColorPalette();
+    return QColor(colors[index % colors.size()]);
+}
+
+// Interpreta una línea "pid, burst, arrival, priority"; false si es comentario o inválida
+static bool parseProcessLine(const QString& rawLine, int colorIndex, Process& p) {
+    QString line = rawLine.trimmed();
+    if (line.isEmpty() || line.startsWith("#")) return false;
+
+    QStringList parts = line.split(",");
+    if (parts.size() < 4) return false;
+
+    p = Process();
+    p.pid = parts[0].trimmed();
+    p.burst_time = parts[1].trimmed().toInt();
+    p.arrival_time = parts[2].trimmed().toInt();
+    p.priority = parts[3].trimmed().toInt();
+    p.remaining_time = p.burst_time;
+    p.color = processColor(colorIndex);
+    return true;
+}
 
 std::vector<Process> loadProcesses(const QString& filename) {
     std::vector<Process> processes;
@@ -15,25 +45,12 @@ std::vector<Process> loadProcesses(const QString& filename) {
     }
     
     QTextStream in(&file);
-    QStringList colors = {"#FF6B6B", "#4ECDC4", "#45B7D1", "#96CEB4", "#FFEAA7", 
-                         "#DDA0DD", "#F0E68C", "#FFB6C1", "#87CEEB", "#98FB98"};
     int colorIndex = 0;
     
     while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (line.isEmpty() || line.startsWith("#")) continue; 
-        
-        QStringList parts = line.split(",");
-        if (parts.size() >= 4) {
-            Process p;
-            p.pid = parts[0].trimmed();
-            p.burst_time = parts[1].trimmed().toInt();
-            p.arrival_time = parts[2].trimmed().toInt();
-            p.priority = parts[3].trimmed().toInt();
-            p.remaining_time = p.burst_time;
-            p.color = QColor(colors[colorIndex % colors.size()]);
+        Process p;
+        if (parseProcessLine(in.readLine(), colorIndex, p)) {
             colorIndex++;
-            
             processes.push_back(p);
         }
     }
@@ -42,6 +59,52 @@ std::vector<Process> loadProcesses(const QString& filename) {
     return processes;
 }
 
+ProcessStream::ProcessStream(const QString& filename)
+    : file(filename), has_pending(false), colorIndex(0), last_arrival(0) {
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open file:" << filename;
+        return;
+    }
+    in.setDevice(&file);
+    readAhead();
+}
+
+bool ProcessStream::isOpen() const {
+    return file.isOpen();
+}
+
+bool ProcessStream::hasNext() const {
+    return has_pending;
+}
+
+const Process& ProcessStream::peek() const {
+    return pending;
+}
+
+Process ProcessStream::next() {
+    Process current = pending;
+    readAhead();
+    return current;
+}
+
+void ProcessStream::readAhead() {
+    has_pending = false;
+    while (file.isOpen() && !in.atEnd()) {
+        if (parseProcessLine(in.readLine(), colorIndex, pending)) {
+            colorIndex++;
+            if (pending.arrival_time < last_arrival) {
+                qDebug() << "Process" << pending.pid << "arrives before the previous one; stream expects arrival order";
+            }
+            last_arrival = std::max(last_arrival, pending.arrival_time);
+            has_pending = true;
+            return;
+        }
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+}
+
 std::vector<Resource> loadResources(const QString& filename) {
     std::vector<Resource> resources;
     QFile file(filename);
@@ -92,6 +155,14 @@ std::vector<Action> loadActions(const QString& filename) {
             a.type = parts[1].trimmed().toUpper();
             a.resource = parts[2].trimmed();
             a.cycle = parts[3].trimmed().toInt();
+            // Quinta columna opcional: duración de la sección crítica
+            if (parts.size() >= 5) {
+                a.duration = parts[4].trimmed().toInt();
+                if (a.duration < 1) {
+                    qDebug() << "Action of" << a.pid << "on" << a.resource << "has invalid duration" << parts[4].trimmed() << "- using 1";
+                    a.duration = 1;
+                }
+            }
             
             actions.push_back(a);
         }
@@ -99,4 +170,34 @@ std::vector<Action> loadActions(const QString& filename) {
     
     file.close();
     return actions;
-}
\ No newline at end of file
+}
+
+// Una línea "pid, resource, units" por reclamo máximo
+std::vector<Claim> loadClaims(const QString& filename) {
+    std::vector<Claim> claims;
+    QFile file(filename);
+    
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open file:" << filename;
+        return claims;
+    }
+    
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith("#")) continue;
+        
+        QStringList parts = line.split(",");
+        if (parts.size() >= 3) {
+            Claim c;
+            c.pid = parts[0].trimmed();
+            c.resource = parts[1].trimmed();
+            c.units = parts[2].trimmed().toInt();
+            
+            claims.push_back(c);
+        }
+    }
+    
+    file.close();
+    return claims;
+}
@@ -4,9 +4,36 @@
 #include "utils.h"
 #include <vector>
 #include <QString>
+#include <QFile>
+#include <QTextStream>
 
 std::vector<Process> loadProcesses(const QString& filename);
 std::vector<Resource> loadResources(const QString& filename);
 std::vector<Action> loadActions(const QString& filename);
+std::vector<Claim> loadClaims(const QString& filename);
+// Color de la paleta de procesos para el i-ésimo proceso cargado
+QColor processColor(int index);
+
+// Lectura incremental de un archivo de procesos ordenado por llegada.
+// Solo mantiene en memoria el siguiente proceso (lookahead de una línea).
+class ProcessStream {
+public:
+    explicit ProcessStream(const QString& filename);
+
+    bool isOpen() const;
+    bool hasNext() const;
+    const Process& peek() const;
+    Process next();
+
+private:
+    void readAhead();
+
+    QFile file;
+    QTextStream in;
+    Process pending;
+    bool has_pending;
+    int colorIndex;
+    int last_arrival;
+};
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,418 @@
+// Perfilador de cerrojos para LD_PRELOAD: intercepta los pthread_mutex_* y
+// pthread_rwlock_* de cualquier programa y, al salir, escribe una traza con
+// el formato de actions.txt ("pid, tipo, recurso, ciclo, duración") que
+// loadActions puede reproducir en el simulador.
+//
+// El simulador solo deja a un proceso obtener un recurso por ciclo y descarta
+// el resto de sus peticiones de ese ciclo, así que los ciclos de cada hilo se
+// escriben estrictamente crecientes: una petición va como pronto un ciclo
+// después de la anterior del hilo y, si ya había soltado las anteriores,
+// cuando acaba la última de ellas. Una petición hecha reteniendo otro cerrojo
+// alarga ese tramo para que lo siga cubriendo. La cabecera dice cuántas
+// peticiones hubo que retrasar (con ciclos más cortos, menos).
+//
+// loadActions lee ciclos y duraciones como int: las peticiones que caen en el
+// ciclo INT_MAX o después se omiten y las duraciones se recortan para que el
+// tramo acabe antes; ambas cosas se avisan (con ciclos más largos, ninguna).
+//
+//   LD_PRELOAD=./liblockprof.so LOCKPROF_OUTPUT=actions.txt LOCKPROF_CYCLE_NS=1000 ./programa
+//
+// Sin Qt ni STL en el camino caliente: cada hilo apunta en su propio búfer
+// (trozos con mmap enlazados) y la lista global de búferes solo se toca con
+// un CAS al nacer el hilo. Todo se ordena y se escribe en el destructor.
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#include <atomic>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Record {
+    uint64_t requested;   // ns al pedirlo
+    uint64_t acquired;    // ns al obtenerlo
+    uint64_t released;    // ns al soltarlo
+    uintptr_t lock;
+    int32_t tid;
+    bool write;
+};
+
+constexpr size_t kChunkRecords = 1 << 12;
+constexpr int kMaxHeld = 64; // cerrojos retenidos a la vez por un hilo
+
+struct Chunk {
+    std::atomic<Chunk*> next;
+    std::atomic<uint32_t> count;
+    Record records[kChunkRecords];
+};
+
+struct Held {
+    uintptr_t lock;
+    uint64_t requested;
+    uint64_t acquired;
+    int depth;            // recursivos: solo cuenta la primera entrada
+    bool write;
+};
+
+struct ThreadLog {
+    ThreadLog* next;      // lista global de hilos
+    Chunk* head;
+    Chunk* current;
+    int32_t tid;
+    int held_count;
+    Held held[kMaxHeld];
+};
+
+std::atomic<ThreadLog*> g_logs{nullptr};
+std::atomic<bool> g_stopped{false};
+std::atomic<uint64_t> g_dropped{0};
+
+__thread ThreadLog* t_log __attribute__((tls_model("initial-exec"))) = nullptr;
+__thread bool t_busy __attribute__((tls_model("initial-exec"))) = false; // evita reentrar desde el propio perfilador
+
+using MutexFn = int (*)(pthread_mutex_t*);
+using RwFn = int (*)(pthread_rwlock_t*);
+using CondWaitFn = int (*)(pthread_cond_t*, pthread_mutex_t*);
+using CondTimedFn = int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+
+MutexFn real_mutex_lock, real_mutex_trylock, real_mutex_unlock;
+RwFn real_rdlock, real_wrlock, real_tryrdlock, real_trywrlock, real_rw_unlock;
+CondWaitFn real_cond_wait;
+CondTimedFn real_cond_timedwait;
+
+template<class Fn>
+void resolve(Fn& fn, const char* name) {
+    fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+}
+
+// dlsym puede tomar cerrojos: se resuelve todo antes de que corra main
+__attribute__((constructor)) void resolveAll() {
+    t_busy = true;
+    resolve(real_mutex_lock, "pthread_mutex_lock");
+    resolve(real_mutex_trylock, "pthread_mutex_trylock");
+    resolve(real_mutex_unlock, "pthread_mutex_unlock");
+    resolve(real_rdlock, "pthread_rwlock_rdlock");
+    resolve(real_wrlock, "pthread_rwlock_wrlock");
+    resolve(real_tryrdlock, "pthread_rwlock_tryrdlock");
+    resolve(real_trywrlock, "pthread_rwlock_trywrlock");
+    resolve(real_rw_unlock, "pthread_rwlock_unlock");
+    // Misma versión de símbolo que enlaza el programa, no la antigua de glibc
+    real_cond_wait = reinterpret_cast<CondWaitFn>(dlvsym(RTLD_NEXT, "pthread_cond_wait", "GLIBC_2.3.2"));
+    real_cond_timedwait = reinterpret_cast<CondTimedFn>(dlvsym(RTLD_NEXT, "pthread_cond_timedwait", "GLIBC_2.3.2"));
+    if (!real_cond_wait) resolve(real_cond_wait, "pthread_cond_wait");
+    if (!real_cond_timedwait) resolve(real_cond_timedwait, "pthread_cond_timedwait");
+    t_busy = false;
+}
+
+uint64_t nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+template<class T>
+T* mapZeroed() {
+    void* memory = mmap(nullptr, sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : static_cast<T*>(memory);
+}
+
+// Búfer del hilo; se crea en su primera operación y nunca se libera para que
+// la traza sobreviva al hilo
+ThreadLog* threadLog() {
+    if (t_log) return t_log;
+    ThreadLog* log = mapZeroed<ThreadLog>();
+    if (!log) return nullptr;
+    log->tid = static_cast<int32_t>(syscall(SYS_gettid));
+    log->head = log->current = mapZeroed<Chunk>();
+    if (!log->head) return nullptr;
+    ThreadLog* first = g_logs.load(std::memory_order_relaxed);
+    do {
+        log->next = first;
+    } while (!g_logs.compare_exchange_weak(first, log, std::memory_order_release, std::memory_order_relaxed));
+    t_log = log;
+    return log;
+}
+
+bool tracing() {
+    return !t_busy && !g_stopped.load(std::memory_order_relaxed);
+}
+
+Held* findHeld(ThreadLog* log, uintptr_t lock) {
+    for (int i = log->held_count - 1; i >= 0; i--) {
+        if (log->held[i].lock == lock) return &log->held[i];
+    }
+    return nullptr;
+}
+
+void onAcquired(const void* lock, uint64_t requested, bool write) {
+    ThreadLog* log = threadLog();
+    if (!log) return;
+    uintptr_t address = reinterpret_cast<uintptr_t>(lock);
+    if (Held* held = findHeld(log, address)) {
+        held->depth++; // recursivo o segundo rdlock del mismo hilo
+        return;
+    }
+    if (log->held_count == kMaxHeld) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    log->held[log->held_count++] = Held{address, requested, nowNs(), 1, write};
+}
+
+void onReleased(const void* lock) {
+    ThreadLog* log = t_log;
+    if (!log) return;
+    Held* held = findHeld(log, reinterpret_cast<uintptr_t>(lock));
+    if (!held || --held->depth > 0) return;
+
+    Chunk* chunk = log->current;
+    uint32_t count = chunk->count.load(std::memory_order_relaxed);
+    if (count == kChunkRecords) {
+        Chunk* fresh = mapZeroed<Chunk>();
+        if (!fresh) {
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+            *held = log->held[--log->held_count];
+            return;
+        }
+        chunk->next.store(fresh, std::memory_order_release);
+        log->current = chunk = fresh;
+        count = 0;
+    }
+    chunk->records[count] = Record{held->requested, held->acquired, nowNs(), held->lock, log->tid, held->write};
+    chunk->count.store(count + 1, std::memory_order_release);
+    *held = log->held[--log->held_count];
+}
+
+uint64_t envNumber(const char* name, uint64_t fallback) {
+    const char* value = getenv(name);
+    if (!value || !*value) return fallback;
+    uint64_t parsed = strtoull(value, nullptr, 10);
+    return parsed > 0 ? parsed : fallback;
+}
+
+// Al salir: todos los tramos ordenados por petición, ciclos desde el primero
+__attribute__((destructor)) void writeTrace() {
+    g_stopped.store(true, std::memory_order_seq_cst);
+    t_busy = true;
+
+    std::vector<Record> records;
+    for (ThreadLog* log = g_logs.load(std::memory_order_acquire); log; log = log->next) {
+        for (Chunk* chunk = log->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            uint32_t count = chunk->count.load(std::memory_order_acquire);
+            records.insert(records.end(), chunk->records, chunk->records + count);
+        }
+    }
+    if (records.empty()) return;
+    std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.requested < b.requested;
+    });
+
+    const uint64_t cycle_ns = envNumber("LOCKPROF_CYCLE_NS", 1000);
+    char default_path[64];
+    snprintf(default_path, sizeof(default_path), "lockprof-%d.txt", static_cast<int>(getpid()));
+    const char* path = getenv("LOCKPROF_OUTPUT");
+    FILE* out = fopen(path && *path ? path : default_path, "w");
+    if (!out) {
+        fprintf(stderr, "lockprof: cannot open %s\n", path && *path ? path : default_path);
+        return;
+    }
+
+    // Ciclo y duración de cada petición, en orden de petición
+    struct Line {
+        const Record* record;
+        uint64_t cycle;
+        uint64_t duration;
+        int name;
+    };
+    struct ThreadCycles {
+        bool any = false;
+        uint64_t last = 0;        // ciclo de su última petición
+        uint64_t free = 0;        // fin del último tramo ya soltado
+        std::vector<size_t> open; // tramos que retiene todavía
+    };
+    // Nombres cortos y estables: L1, L2... por orden de primer uso
+    std::unordered_map<uintptr_t, int> lock_names;
+    std::unordered_map<int32_t, ThreadCycles> threads;
+    std::vector<Line> lines;
+    lines.reserve(records.size());
+    const uint64_t origin = records.front().requested;
+    size_t shifted = 0;
+    for (const Record& record : records) {
+        const int name = lock_names.emplace(record.lock, static_cast<int>(lock_names.size()) + 1).first->second;
+        const uint64_t measured = (record.requested - origin) / cycle_ns;
+        // La sección crítica dura desde que lo obtuvo, no desde que lo pidió
+        const uint64_t duration = std::max<uint64_t>((record.released - record.acquired + cycle_ns - 1) / cycle_ns, 1);
+
+        ThreadCycles& thread = threads[record.tid];
+        auto still_open = thread.open.begin();
+        for (size_t held : thread.open) {
+            if (lines[held].record->released <= record.requested) {
+                thread.free = std::max(thread.free, lines[held].cycle + lines[held].duration);
+            } else {
+                *still_open++ = held;
+            }
+        }
+        thread.open.erase(still_open, thread.open.end());
+
+        uint64_t cycle = std::max(measured, thread.free);
+        if (thread.any) {
+            cycle = std::max(cycle, thread.last + 1);
+        }
+        shifted += cycle != measured ? 1 : 0;
+        for (size_t held : thread.open) {
+            lines[held].duration = std::max(lines[held].duration, cycle + duration - lines[held].cycle);
+        }
+        thread.open.push_back(lines.size());
+        thread.any = true;
+        thread.last = cycle;
+        lines.push_back(Line{&record, cycle, duration, name});
+    }
+    // Por ciclo; a igualdad, en orden de petición
+    std::stable_sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) {
+        return a.cycle < b.cycle;
+    });
+
+    // Lo que no cabe en un int: fuera las peticiones y recortados los tramos
+    const uint64_t limit = INT_MAX;
+    size_t omitted = 0;
+    size_t clamped = 0;
+    while (!lines.empty() && lines.back().cycle >= limit) {
+        lines.pop_back();
+        omitted++;
+    }
+    for (Line& line : lines) {
+        if (line.duration > limit - line.cycle) {
+            line.duration = limit - line.cycle;
+            clamped++;
+        }
+    }
+
+    fprintf(out, "# lockprof: pid %d, %zu acquisitions, cycle %llu ns, %llu dropped, %zu shifted, %zu omitted\n",
+            static_cast<int>(getpid()), records.size(),
+            static_cast<unsigned long long>(cycle_ns),
+            static_cast<unsigned long long>(g_dropped.load()), shifted, omitted);
+    if (shifted > 0) {
+        fprintf(stderr, "lockprof: %zu of %zu requests delayed to keep one per thread and cycle; "
+                        "a smaller LOCKPROF_CYCLE_NS keeps them closer to the measured times\n",
+                shifted, records.size());
+    }
+    if (omitted > 0 || clamped > 0) {
+        fprintf(stderr, "lockprof: %zu requests past cycle %d omitted and %zu durations shortened to fit the "
+                        "trace format; a larger LOCKPROF_CYCLE_NS avoids it\n",
+                omitted, INT_MAX, clamped);
+    }
+    fprintf(out, "# pid, type, resource, cycle, duration\n");
+    for (const Line& line : lines) {
+        fprintf(out, "T%d, %s, L%d, %llu, %llu\n", line.record->tid, line.record->write ? "WRITE" : "READ", line.name,
+                static_cast<unsigned long long>(line.cycle),
+                static_cast<unsigned long long>(line.duration));
+    }
+    fclose(out);
+}
+
+} // namespace
+
+extern "C" {
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    if (!real_mutex_lock) resolveAll();
+    if (!tracing()) return real_mutex_lock(mutex);
+    uint64_t requested = nowNs();
+    int result = real_mutex_lock(mutex);
+    if (result == 0) onAcquired(mutex, requested, true);
+    return result;
+}
+
+int pthread_mutex_trylock(pthread_mutex_t* mutex) {
+    if (!real_mutex_trylock) resolveAll();
+    if (!tracing()) return real_mutex_trylock(mutex);
+    uint64_t requested = nowNs();
+    int result = real_mutex_trylock(mutex);
+    if (result == 0) onAcquired(mutex, requested, true);
+    return result;
+}
+
+int pthread_mutex_unlock(pthread_mutex_t* mutex) {
+    if (!real_mutex_unlock) resolveAll();
+    if (tracing()) onReleased(mutex);
+    return real_mutex_unlock(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* rwlock) {
+    if (!real_rdlock) resolveAll();
+    if (!tracing()) return real_rdlock(rwlock);
+    uint64_t requested = nowNs();
+    int result = real_rdlock(rwlock);
+    if (result == 0) onAcquired(rwlock, requested, false);
+    return result;
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* rwlock) {
+    if (!real_wrlock) resolveAll();
+    if (!tracing()) return real_wrlock(rwlock);
+    uint64_t requested = nowNs();
+    int result = real_wrlock(rwlock);
+    if (result == 0) onAcquired(rwlock, requested, true);
+    return result;
+}
+
+int pthread_rwlock_tryrdlock(pthread_rwlock_t* rwlock) {
+    if (!real_tryrdlock) resolveAll();
+    if (!tracing()) return real_tryrdlock(rwlock);
+    uint64_t requested = nowNs();
+    int result = real_tryrdlock(rwlock);
+    if (result == 0) onAcquired(rwlock, requested, false);
+    return result;
+}
+
+int pthread_rwlock_trywrlock(pthread_rwlock_t* rwlock) {
+    if (!real_trywrlock) resolveAll();
+    if (!tracing()) return real_trywrlock(rwlock);
+    uint64_t requested = nowNs();
+    int result = real_trywrlock(rwlock);
+    if (result == 0) onAcquired(rwlock, requested, true);
+    return result;
+}
+
+int pthread_rwlock_unlock(pthread_rwlock_t* rwlock) {
+    if (!real_rw_unlock) resolveAll();
+    if (tracing()) onReleased(rwlock);
+    return real_rw_unlock(rwlock);
+}
+
+// La espera de una condición suelta y vuelve a tomar el mutex por dentro:
+// se anota como una liberación y una nueva adquisición
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+    if (!real_cond_wait) resolveAll();
+    if (!tracing()) return real_cond_wait(cond, mutex);
+    onReleased(mutex);
+    uint64_t requested = nowNs();
+    int result = real_cond_wait(cond, mutex);
+    onAcquired(mutex, requested, true);
+    return result;
+}
+
+int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* abstime) {
+    if (!real_cond_timedwait) resolveAll();
+    if (!tracing()) return real_cond_timedwait(cond, mutex, abstime);
+    onReleased(mutex);
+    uint64_t requested = nowNs();
+    int result = real_cond_timedwait(cond, mutex, abstime);
+    onAcquired(mutex, requested, true);
+    return result;
+}
+
+}
@@ -0,0 +1,379 @@
+#include "processmodel.h"
+#include "timingwheel.h"
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <queue>
+
+int ProcessModel::beginProcess(const Process& process) {
+    Program program;
+    program.process = process;
+    program.first_step = static_cast<int>(steps.size());
+    processes.push_back(program);
+    return static_cast<int>(processes.size()) - 1;
+}
+
+void ProcessModel::addStep(const ProcessStep& step) {
+    if (processes.empty()) {
+        qDebug() << "Step added before any process; call beginProcess first";
+        return;
+    }
+    steps.push_back(step);
+    processes.back().step_count++;
+}
+
+void ProcessModel::cpu(int ticks) {
+    if (ticks <= 0) return;
+    ProcessStep step;
+    step.kind = StepKind::CPU;
+    step.amount = ticks;
+    addStep(step);
+}
+
+void ProcessModel::io(int ticks) {
+    if (ticks <= 0) return;
+    ProcessStep step;
+    step.kind = StepKind::IO;
+    step.amount = ticks;
+    addStep(step);
+}
+
+void ProcessModel::acquire(const QString& resource, AccessType access) {
+    ProcessStep step;
+    step.kind = StepKind::ACQUIRE;
+    step.resource = resource_names.intern(resource);
+    step.access = access;
+    addStep(step);
+}
+
+void ProcessModel::release(const QString& resource) {
+    ProcessStep step;
+    step.kind = StepKind::RELEASE;
+    step.resource = resource_names.intern(resource);
+    addStep(step);
+}
+
+ProcessModel ProcessModel::fromWorkload(const std::vector<Process>& processes, const std::vector<Action>& actions) {
+    std::map<QString, std::vector<const Action*>> by_pid;
+    for (const auto& action : actions) {
+        by_pid[action.pid].push_back(&action);
+    }
+
+    ProcessModel model;
+    for (const auto& process : processes) {
+        model.beginProcess(process);
+        int done = 0; // ticks de CPU ya puestos
+        auto found = by_pid.find(process.pid);
+        if (found != by_pid.end()) {
+            std::vector<const Action*>& own = found->second;
+            std::stable_sort(own.begin(), own.end(), [](const Action* a, const Action* b) {
+                return a->cycle < b->cycle;
+            });
+            for (const Action* action : own) {
+                const int offset = std::max(action->cycle - process.arrival_time, done);
+                model.cpu(offset - done);
+                model.acquire(action->resource, parseAccessType(action->type));
+                const int hold = std::max(action->duration, 1);
+                model.cpu(hold);
+                model.release(action->resource);
+                done = offset + hold;
+            }
+        }
+        model.cpu(process.burst_time - done);
+    }
+    return model;
+}
+
+namespace {
+
+struct ReadyEntry {
+    long long key;  // menor primero según la política
+    long long seq;
+    ProcessFrame* frame;
+    bool operator>(const ReadyEntry& other) const {
+        return key != other.key ? key > other.key : seq > other.seq;
+    }
+};
+
+// Qué hizo el proceso al reanudarse
+enum class Resume {
+    NEEDS_CPU, // está en un paso CPU
+    IN_IO,
+    BLOCKED,
+    FINISHED
+};
+
+} // namespace
+
+ProcessModelResult ProcessModel::run(ModelPolicy policy, int quantum, SynchronizationMechanism* mechanism) const {
+    ProcessModelResult result;
+    const int count = processCount();
+    result.processes.reserve(count);
+    for (const auto& program : processes) {
+        result.processes.push_back(program.process);
+    }
+    result.stats.resize(count);
+    if (count == 0) return result;
+    quantum = std::max(quantum, 1);
+
+    // Ids del mecanismo, internados antes de reiniciarlo para que dimensione bien
+    const int resource_count = resource_names.size();
+    std::vector<int> mechanism_resource(resource_count);
+    std::vector<int> mechanism_pid(count);
+    if (mechanism) {
+        for (int r = 0; r < resource_count; r++) {
+            mechanism_resource[r] = mechanism->resourceId(resource_names.name(r));
+        }
+        for (int p = 0; p < count; p++) {
+            mechanism_pid[p] = mechanism->processId(processes[p].process.pid);
+        }
+        mechanism->resetResources();
+    }
+    const bool wake_all = mechanism && mechanism->releaseWakesAll();
+    const bool ordered = mechanism && mechanism->ordersWaiters();
+
+    std::vector<int> arrivals(count);
+    std::iota(arrivals.begin(), arrivals.end(), 0);
+    std::stable_sort(arrivals.begin(), arrivals.end(), [this](int a, int b) {
+        return processes[a].process.arrival_time < processes[b].process.arrival_time;
+    });
+
+    FramePool<ProcessFrame> pool;
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> ready;
+    TimingWheel<ProcessFrame*> io_events; // fines de E/S
+    std::vector<ProcessFrame*> io_done;
+    std::vector<std::deque<ProcessFrame*>> waiters(resource_count);
+    std::vector<ProcessFrame*> resumable; // desbloqueados pendientes de reanudar
+    std::vector<std::pair<int, ProcessFrame*>> ranked;
+    std::vector<int> unreleased(resource_count, 0);
+    long long seq = 0;
+    int now = 0;
+    bool warned_unreleased = false;
+
+    auto makeReady = [&](ProcessFrame* frame) {
+        const ProcessStep& step = steps[frame->pc];
+        long long key = 0;
+        if (policy == ModelPolicy::SJF) {
+            key = frame->remaining > 0 ? frame->remaining : step.amount;
+        } else if (policy == ModelPolicy::PRIORITY) {
+            key = processes[frame->process].process.priority;
+        }
+        frame->ready_since = now;
+        ready.push(ReadyEntry{key, seq++, frame});
+    };
+
+    // Reintenta las colas tras soltar `resource`; los que lo obtienen pasan
+    // a `resumable` y se reanudan fuera, sin anidar liberaciones
+    auto wake = [&](int resource) {
+        if (!mechanism) return;
+        auto retry = [&](int r) {
+            std::deque<ProcessFrame*>& queue = waiters[r];
+            if (queue.empty()) return;
+            ranked.clear();
+            for (size_t i = 0; i < queue.size(); i++) {
+                ranked.push_back({ordered ? mechanism->waitRank(queue[i]->mechanism_pid) : static_cast<int>(i), queue[i]});
+            }
+            if (ordered) {
+                std::stable_sort(ranked.begin(), ranked.end(),
+                                 [](const auto& a, const auto& b) { return a.first < b.first; });
+            }
+            for (const auto& candidate : ranked) {
+                ProcessFrame* frame = candidate.second;
+                const ProcessStep& step = steps[frame->pc];
+                if (!mechanism->tryAcquire(mechanism_resource[r], frame->mechanism_pid, step.access)) continue;
+                mechanism->onWaitEnd(mechanism_resource[r], frame->mechanism_pid, step.access);
+                queue.erase(std::find(queue.begin(), queue.end(), frame));
+                frame->blocked += now - frame->blocked_since;
+                frame->pc++;
+                resumable.push_back(frame);
+            }
+        };
+        if (wake_all) {
+            for (int r = 0; r < resource_count; r++) retry(r);
+        } else {
+            retry(resource);
+        }
+    };
+
+    auto finish = [&](ProcessFrame* frame) {
+        const Program& program = processes[frame->process];
+        // Suelta lo que el programa adquirió y no liberó
+        if (mechanism) {
+            const int end = program.first_step + program.step_count;
+            for (int s = program.first_step; s < end; s++) {
+                if (steps[s].kind == StepKind::ACQUIRE) unreleased[steps[s].resource]++;
+                if (steps[s].kind == StepKind::RELEASE && unreleased[steps[s].resource] > 0) unreleased[steps[s].resource]--;
+            }
+            for (int s = program.first_step; s < end; s++) {
+                int& held = unreleased[steps[s].resource];
+                if (steps[s].kind != StepKind::ACQUIRE || held == 0) continue;
+                if (!warned_unreleased) {
+                    qDebug() << "Process" << program.process.pid << "finished holding"
+                             << resource_names.name(steps[s].resource) << "; releasing it";
+                    warned_unreleased = true;
+                }
+                for (; held > 0; held--) {
+                    mechanism->release(mechanism_resource[steps[s].resource], frame->mechanism_pid);
+                }
+                wake(steps[s].resource);
+            }
+        }
+        Process& process = result.processes[frame->process];
+        process.start_time = frame->start >= 0 ? frame->start : now;
+        process.finish_time = now;
+        process.waiting_time = frame->waiting;
+        process.turnaround_time = now - process.arrival_time;
+        process.remaining_time = 0;
+        ModelProcessStats& stats = result.stats[frame->process];
+        stats.blocked_time = frame->blocked;
+        stats.io_time = frame->io;
+        stats.lock_waits = frame->lock_waits;
+        pool.release(frame);
+    };
+
+    // Ejecuta pasos sin tiempo desde `pc` hasta el próximo que necesite
+    // CPU, E/S o un recurso ocupado
+    auto resume = [&](ProcessFrame* frame) {
+        const int end = processes[frame->process].first_step + processes[frame->process].step_count;
+        while (frame->pc < end) {
+            const ProcessStep& step = steps[frame->pc];
+            switch (step.kind) {
+            case StepKind::CPU:
+                if (frame->remaining == 0) frame->remaining = step.amount;
+                return Resume::NEEDS_CPU;
+            case StepKind::IO:
+                frame->io += step.amount;
+                io_events.push(now + step.amount, frame);
+                return Resume::IN_IO;
+            case StepKind::ACQUIRE:
+                if (mechanism && !mechanism->tryAcquire(mechanism_resource[step.resource], frame->mechanism_pid, step.access)) {
+                    mechanism->onWait(mechanism_resource[step.resource], frame->mechanism_pid, step.access);
+                    waiters[step.resource].push_back(frame);
+                    frame->blocked_since = now;
+                    frame->lock_waits++;
+                    return Resume::BLOCKED;
+                }
+                frame->pc++;
+                break;
+            case StepKind::RELEASE:
+                if (mechanism) {
+                    mechanism->release(mechanism_resource[step.resource], frame->mechanism_pid);
+                    wake(step.resource);
+                }
+                frame->pc++;
+                break;
+            }
+        }
+        finish(frame);
+        return Resume::FINISHED;
+    };
+
+    auto resumeWaiting = [&]() {
+        while (!resumable.empty()) {
+            ProcessFrame* frame = resumable.back();
+            resumable.pop_back();
+            if (resume(frame) == Resume::NEEDS_CPU) makeReady(frame);
+        }
+    };
+
+    ProcessFrame* running = nullptr;
+    int slice_start = 0;
+    int run_until = 0;
+    int quantum_left = 0;
+    size_t next_arrival = 0;
+
+    for (;;) {
+        // Llegadas y fines de E/S del instante, antes de devolver a la cola
+        // al que agota su quantum (como runRoundRobin)
+        while (next_arrival < arrivals.size() && processes[arrivals[next_arrival]].process.arrival_time <= now) {
+            const int index = arrivals[next_arrival++];
+            ProcessFrame* frame = pool.allocate();
+            frame->process = index;
+            frame->mechanism_pid = mechanism_pid[index];
+            frame->pc = processes[index].first_step;
+            result.peak_frames = std::max(result.peak_frames, pool.live());
+            if (resume(frame) == Resume::NEEDS_CPU) makeReady(frame);
+            resumeWaiting();
+        }
+        io_done.clear();
+        io_events.popUntil(now, io_done);
+        for (ProcessFrame* frame : io_done) {
+            frame->pc++;
+            if (resume(frame) == Resume::NEEDS_CPU) makeReady(frame);
+            resumeWaiting();
+        }
+
+        if (running && run_until <= now) {
+            const int ran = now - slice_start;
+            result.busy_time += ran;
+            running->remaining -= ran;
+            quantum_left -= ran;
+            const Process& process = processes[running->process].process;
+            if (!result.timeline.empty() && result.timeline.back().pid == process.pid
+                && result.timeline.back().start_time + result.timeline.back().duration == slice_start) {
+                result.timeline.back().duration += ran;
+            } else {
+                result.timeline.push_back(ExecutionSlice(process.pid, slice_start, ran, process.color));
+            }
+
+            ProcessFrame* frame = running;
+            running = nullptr;
+            if (frame->remaining > 0) {
+                makeReady(frame); // expropiado por el quantum
+            } else {
+                frame->pc++;
+                // Sigue en la CPU si su siguiente paso de CPU llega sin ceder
+                if (resume(frame) == Resume::NEEDS_CPU) {
+                    if (policy != ModelPolicy::ROUND_ROBIN || quantum_left > 0) {
+                        running = frame;
+                    } else {
+                        makeReady(frame);
+                    }
+                }
+            }
+            resumeWaiting();
+        }
+
+        if (!running && !ready.empty()) {
+            running = ready.top().frame;
+            ready.pop();
+            running->waiting += now - running->ready_since;
+            if (running->start < 0) running->start = now;
+            quantum_left = quantum;
+        }
+        if (running && run_until <= now) {
+            slice_start = now;
+            run_until = now + (policy == ModelPolicy::ROUND_ROBIN ? std::min(running->remaining, quantum_left)
+                                                                  : running->remaining);
+        }
+
+        // Siguiente instante con algo que hacer
+        long long next = LLONG_MAX;
+        if (running) next = run_until;
+        if (!io_events.empty()) next = std::min(next, io_events.nextTime());
+        if (next_arrival < arrivals.size()) {
+            next = std::min<long long>(next, processes[arrivals[next_arrival]].process.arrival_time);
+        }
+        if (next == LLONG_MAX) break;
+        now = static_cast<int>(next);
+    }
+    result.end_time = now;
+
+    // Lo que sigue en las colas no lo va a liberar nadie
+    for (int r = 0; r < resource_count; r++) {
+        for (ProcessFrame* frame : waiters[r]) {
+            result.deadlocked.push_back(frame->process);
+            result.stats[frame->process].blocked_time = frame->blocked + (now - frame->blocked_since);
+            result.stats[frame->process].lock_waits = frame->lock_waits;
+        }
+    }
+    std::sort(result.deadlocked.begin(), result.deadlocked.end());
+    if (!result.deadlocked.empty()) {
+        qDebug() << result.deadlocked.size() << "processes never got their resources";
+    }
+    return result;
+}
@@ -0,0 +1,145 @@
+#ifndef PROCESSMODEL_H
+#define PROCESSMODEL_H
+
+#include "utils.h"
+#include "synchronizer.h"
+#include <QString>
+#include <memory>
+#include <vector>
+
+// Un paso del programa de un proceso
+enum class StepKind {
+    CPU,     // `amount` ticks en la CPU
+    IO,      // `amount` ticks fuera de la CPU sin ocupar a nadie
+    ACQUIRE, // pide `resource` al mecanismo; si no lo obtiene se bloquea
+    RELEASE  // suelta `resource` y despierta a quien lo esperaba
+};
+
+struct ProcessStep {
+    StepKind kind = StepKind::CPU;
+    int amount = 0;
+    int resource = -1;                     // id en ProcessModel::resourceNames()
+    AccessType access = AccessType::WRITE;
+};
+
+// Cómo elige el motor el siguiente proceso listo (una sola CPU)
+enum class ModelPolicy {
+    FIFO,        // orden de llegada a la cola de listos
+    SJF,         // menor ráfaga de CPU siguiente
+    ROUND_ROBIN, // turnos de `quantum` ticks
+    PRIORITY     // menor número = más prioritario, sin expropiar
+};
+
+// Estado de un proceso vivo. Los crea y recicla FramePool, así que la
+// memoria es proporcional a los procesos vivos y no a los de la carga.
+struct ProcessFrame {
+    int process = 0;        // índice en el modelo
+    int mechanism_pid = 0;  // id del proceso en el mecanismo
+    int pc = 0;             // paso actual (índice absoluto en los pasos del modelo)
+    int remaining = 0;      // ticks que le quedan al paso CPU o IO actual
+    int ready_since = 0;
+    int blocked_since = 0;
+    int start = -1;         // primer tick en la CPU
+    int waiting = 0;        // en la cola de listos
+    int blocked = 0;        // esperando un recurso
+    int io = 0;
+    int lock_waits = 0;     // veces que se bloqueó
+};
+
+// Bloques fijos de T con lista libre: reservar y liberar son O(1) y nunca
+// tocan el montón salvo para estrenar un bloque de BlockSize.
+template <class T, size_t BlockSize = 4096>
+class FramePool {
+public:
+    T* allocate() {
+        in_use++;
+        if (!free_list.empty()) {
+            T* frame = free_list.back();
+            free_list.pop_back();
+            *frame = T();
+            return frame;
+        }
+        if (blocks.empty() || used == BlockSize) {
+            blocks.emplace_back(new T[BlockSize]);
+            used = 0;
+        }
+        return &blocks.back()[used++];
+    }
+    void release(T* frame) {
+        in_use--;
+        free_list.push_back(frame);
+    }
+    size_t capacity() const { return blocks.size() * BlockSize; }
+    size_t live() const { return in_use; }
+
+private:
+    std::vector<std::unique_ptr<T[]>> blocks;
+    std::vector<T*> free_list;
+    size_t used = 0;
+    size_t in_use = 0;
+};
+
+struct ModelProcessStats {
+    int blocked_time = 0; // ticks bloqueado en recursos
+    int io_time = 0;
+    int lock_waits = 0;
+};
+
+struct ProcessModelResult {
+    std::vector<ExecutionSlice> timeline;
+    // Mismo orden que el modelo; waiting_time es el tiempo en la cola de
+    // listos (no cuenta bloqueos ni E/S), turnaround_time = fin − llegada
+    std::vector<Process> processes;
+    std::vector<ModelProcessStats> stats;
+    std::vector<int> deadlocked;  // índices de procesos que quedaron bloqueados para siempre
+    int end_time = 0;
+    int busy_time = 0;            // ticks con la CPU ocupada
+    size_t peak_frames = 0;       // procesos vivos a la vez, como máximo
+};
+
+// Procesos como programas de pasos CPU / IO / ACQUIRE / RELEASE que un solo
+// motor por eventos ejecuta: un proceso que no obtiene un recurso sale de la
+// cola de listos hasta que se lo liberan, y uno en E/S deja la CPU a otro.
+// Es la versión C++17 de un proceso corrutina: `pc` y `remaining` son el
+// punto de reanudación y cada paso sin tiempo (ACQUIRE, RELEASE) se ejecuta
+// en el mismo instante que el anterior.
+class ProcessModel {
+public:
+    // Los pasos de cada proceso van seguidos: beginProcess abre uno y los
+    // cpu/io/acquire/release siguientes son suyos
+    int beginProcess(const Process& process);
+    void cpu(int ticks);
+    void io(int ticks);
+    void acquire(const QString& resource, AccessType access = AccessType::WRITE);
+    void release(const QString& resource);
+
+    // Un programa por proceso a partir de la carga de los dos simuladores:
+    // cada acción de la traza ocurre tras (cycle − arrival_time) ticks de CPU
+    // del proceso, retiene el recurso `duration` ticks de CPU y lo suelta; lo
+    // que quede de burst_time va al final. Las secciones se hacen en orden,
+    // sin anidar.
+    static ProcessModel fromWorkload(const std::vector<Process>& processes, const std::vector<Action>& actions);
+
+    int processCount() const { return static_cast<int>(processes.size()); }
+    const NameTable& resourceNames() const { return resource_names; }
+
+    // `mechanism` decide las adquisiciones (se reinicia al empezar). Sin
+    // mecanismo, todo ACQUIRE se concede. Lo que un proceso siga reteniendo
+    // al acabar su programa se suelta entonces.
+    ProcessModelResult run(ModelPolicy policy, int quantum, SynchronizationMechanism* mechanism) const;
+
+private:
+    struct Program {
+        Process process;
+        int first_step = 0;
+        int step_count = 0;
+    };
+
+    void addStep(const ProcessStep& step);
+
+    std::vector<Program> processes;
+    std::vector<ProcessStep> steps;
+    NameTable resource_names;
+};
+
+#endif
@@ -6,13 +6,18 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QInputDialog>
+#include <QLineEdit>
 #include <QTextEdit>
 #include <QHeaderView>
 #include <QFont>
 #include <QSpinBox>
 #include <QColor>
+#include <QThread>
+#include <memory>
 #include "ganttchartwidget.h"
 #include "loader.h"
+#include "schedtrace.h"
+#include "kernelreplay.h"
 
 ProcessSimulator::ProcessSimulator(QStackedWidget* mainStack, QWidget* menuWidget_, QWidget *parent)
     : QWidget(parent), mainStack(mainStack), menuWidget_(menuWidget_)
@@ -24,6 +29,11 @@ ProcessSimulator::ProcessSimulator(QStackedWidget* mainStack, QWidget* menuWidge
 
 ProcessSimulator::~ProcessSimulator()
 {
+    // Los trabajadores se matan al vencer el plazo, así que esto acaba
+    if (kernelThread) {
+        kernelThread->wait();
+        delete kernelThread;
+    }
     delete syncMechanism;
 }
 
@@ -173,9 +183,11 @@ void ProcessSimulator::setupAlgorithmSelection(QVBoxLayout* layout) {
 
     QPushButton* runAllBtn = createButton("Simular Algoritmos Seleccionados", "#28a745");
     QPushButton* compareBtn = createButton("Comparar Algoritmos", "#17a2b8");
+    kernelBtn = createButton("Ejecutar en el Kernel", "#6f42c1");
     QHBoxLayout* buttonLayout = new QHBoxLayout();
     buttonLayout->addWidget(runAllBtn);
     buttonLayout->addWidget(compareBtn);
+    buttonLayout->addWidget(kernelBtn);
     layout->addLayout(buttonLayout);
 
     resultsArea = new QWidget();
@@ -191,6 +203,96 @@ void ProcessSimulator::setupAlgorithmSelection(QVBoxLayout* layout) {
         runSelectedAlgorithms();
     });
     connect(compareBtn, &QPushButton::clicked, this, &ProcessSimulator::runSelectedAlgorithmsComparison);
+    connect(kernelBtn, &QPushButton::clicked, this, [this, quantumSpinBox]() {
+        runOnKernel(quantumSpinBox->value());
+    });
+}
+
+// Ejecuta los procesos cargados como trabajadores reales y compara con el modelo
+void ProcessSimulator::runOnKernel(int quantum) {
+    if (kernelThread)
+        return;
+    if (processes.empty()) {
+        QMessageBox::warning(this, "Sin procesos", "Carga procesos antes de ejecutarlos en el kernel.");
+        return;
+    }
+
+    bool ok = false;
+    const QStringList policies = {"SCHED_OTHER", "SCHED_FIFO", "SCHED_RR"};
+    QString policy = QInputDialog::getItem(this, "Ejecutar en el kernel", "Política:", policies, 0, false, &ok);
+    if (!ok)
+        return;
+    QString cpuText = QInputDialog::getText(this, "Ejecutar en el kernel", "CPUs (p. ej. 0 o 2,3; vacío = todas):",
+                                            QLineEdit::Normal, "0", &ok);
+    if (!ok)
+        return;
+    int tick = QInputDialog::getInt(this, "Ejecutar en el kernel", "Microsegundos por unidad de tiempo:",
+                                    10000, 100, 1000000, 100, &ok);
+    if (!ok)
+        return;
+
+    KernelReplayOptions options;
+    options.policy = static_cast<KernelPolicy>(policies.indexOf(policy));
+    options.tick_us = tick;
+    options.cpus.clear();
+    for (const QString& cpu : cpuText.split(",", Qt::SkipEmptyParts)) {
+        bool valid = false;
+        const int id = cpu.trimmed().toInt(&valid);
+        if (!valid || id < 0) {
+            QMessageBox::warning(this, "CPU no válida", QString("\"%1\" no es un número de CPU.").arg(cpu.trimmed()));
+            return;
+        }
+        options.cpus.push_back(id);
+    }
+
+    // Dura lo que tarden los trabajadores (hasta el plazo si alguno no
+    // acaba): fuera del hilo de la interfaz, con una copia de los procesos
+    auto measured = std::make_shared<KernelReplayResult>();
+    auto predictions = std::make_shared<std::vector<KernelModelComparison>>();
+    kernelThread = QThread::create([measured, predictions, options, quantum, processes = processes]() {
+        *measured = KernelReplay::run(processes, options);
+        if (measured->error.isEmpty()) {
+            *predictions = KernelReplay::compare(processes, *measured, options.policy, quantum);
+        }
+    });
+    connect(kernelThread, &QThread::finished, this, [this, measured, predictions, policy, cpuText, tick]() {
+        kernelThread->deleteLater();
+        kernelThread = nullptr;
+        kernelBtn->setEnabled(true);
+        if (!measured->error.isEmpty()) {
+            statusLabel->setText("Kernel run refused");
+            QMessageBox::warning(this, "Ejecutar en el kernel", "No se pudo ejecutar en el kernel: " + measured->error);
+            return;
+        }
+
+        QString report = QString("%1 en CPUs [%2], %3 µs por unidad\n"
+                                 "Medido: espera media %4, turnaround medio %5\n")
+                             .arg(policy).arg(cpuText).arg(tick)
+                             .arg(measured->avg_waiting, 0, 'f', 2).arg(measured->avg_turnaround, 0, 'f', 2);
+        for (const auto& prediction : *predictions) {
+            report += QString("%1: espera %2 (error medio %3, máx. %4), turnaround %5 (error medio %6)\n")
+                          .arg(prediction.algorithm)
+                          .arg(prediction.avg_waiting, 0, 'f', 2).arg(prediction.waiting_mean_abs_error, 0, 'f', 2)
+                          .arg(prediction.waiting_max_abs_error, 0, 'f', 2)
+                          .arg(prediction.avg_turnaround, 0, 'f', 2).arg(prediction.turnaround_mean_abs_error, 0, 'f', 2);
+        }
+        if (measured->policy_fallbacks > 0) {
+            report += QString("%1 trabajadores siguieron en SCHED_OTHER (sin permisos de tiempo real)\n").arg(measured->policy_fallbacks);
+        }
+        if (measured->affinity_failures > 0) {
+            report += QString("%1 trabajadores no se pudieron fijar a las CPUs pedidas\n").arg(measured->affinity_failures);
+        }
+        if (measured->killed > 0) {
+            report += QString("%1 trabajadores no terminaron a tiempo\n").arg(measured->killed);
+        }
+        report += QString("Retraso máximo al crear trabajadores: %1").arg(measured->max_fork_lag, 0, 'f', 2);
+
+        statusLabel->setText(QString("Kernel run finished: average waiting %1").arg(measured->avg_waiting, 0, 'f', 2));
+        QMessageBox::information(this, "Kernel frente al modelo", report);
+    });
+    kernelBtn->setEnabled(false);
+    statusLabel->setText("Running workers on the kernel...");
+    kernelThread->start();
 }
 
 void ProcessSimulator::runSelectedAlgorithms() {
@@ -421,6 +523,38 @@ void ProcessSimulator::loadProcessesFromDialog()
     QMessageBox::information(this, "Archivo cargado", QString("Se cargaron %1 procesos desde %2").arg(processes.size()).arg(fileName));
 }
 
+// Procesos a partir de un volcado de texto de `perf sched script` o ftrace
+void ProcessSimulator::importSchedTraceFromDialog()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Import Scheduler Trace", "", "Trace Files (*.txt *.trace);;All Files (*)");
+    if (fileName.isEmpty())
+        return;
+
+    bool ok = false;
+    QString mode = QInputDialog::getItem(this, "Importar traza", "Un proceso por:",
+                                         {"Ráfaga (despertar → dormir)", "Tarea"}, 0, false, &ok);
+    if (!ok)
+        return;
+    int tick = QInputDialog::getInt(this, "Importar traza", "Microsegundos por unidad de tiempo:", 1000, 1, 1000000, 1, &ok);
+    if (!ok)
+        return;
+
+    SchedTraceOptions options;
+    options.mode = mode == "Tarea" ? SchedTraceMode::PER_TASK : SchedTraceMode::PER_BURST;
+    options.tick_us = tick;
+    SchedTraceStats stats;
+    processes = loadSchedTrace(fileName, options, &stats);
+    originalProcesses = processes;
+    updateProcessTable();
+    statusLabel->setText(QString("Imported %1 processes from %2 tasks (%3 sched events, %4 unreadable, %5 ms traced)")
+                             .arg(processes.size()).arg(stats.tasks).arg(stats.events)
+                             .arg(stats.unparsed).arg(stats.span_us / 1000));
+
+    if (mainGanttChart) {
+        mainGanttChart->setTimeline(std::vector<ExecutionSlice>());
+    }
+}
+
 void ProcessSimulator::setupUI(QWidget* menuWidget_)
 {
     setWindowTitle("Advanced Process Scheduling & Synchronization Simulator");
@@ -532,9 +666,11 @@ void ProcessSimulator::setupSchedulingWidget(QWidget* menuWidget_)
 
     QHBoxLayout *processLayout = new QHBoxLayout();
     QPushButton *loadBtn = createButton("Load Processes", "#6c85bd");
+    QPushButton *importBtn = createButton("Import Trace", "#5a68a5");
     QPushButton *generateBtn = createButton("Generate Sample", "#70a1a8");
     QPushButton *cleanBtn = createButton("Clear", "#dc3545"); 
     processLayout->addWidget(loadBtn);
+    processLayout->addWidget(importBtn);
     processLayout->addWidget(generateBtn);
     processLayout->addWidget(cleanBtn); 
     processLayout->addStretch();
@@ -592,6 +728,7 @@ void ProcessSimulator::setupSchedulingWidget(QWidget* menuWidget_)
 
     connect(backBtn, &QPushButton::clicked, this, &ProcessSimulator::returnToMenuRequested);
     connect(loadBtn, &QPushButton::clicked, this, &ProcessSimulator::loadProcessesFromDialog);
+    connect(importBtn, &QPushButton::clicked, this, &ProcessSimulator::importSchedTraceFromDialog);
     connect(generateBtn, &QPushButton::clicked, this, &ProcessSimulator::generateSampleProcesses);
     connect(cleanBtn, &QPushButton::clicked, this, &ProcessSimulator::cleanProcesses); 
     //connect(startBtn, &QPushButton::clicked, mainGanttChart, &GanttChartWidget::startAnimation);
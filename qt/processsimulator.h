@@ -18,6 +18,8 @@
 #include "loader.h"
 #include "utils.h"
 
+class QThread;
+
 class ProcessSimulator : public QWidget {
     Q_OBJECT
 
@@ -86,6 +88,8 @@ private:
     QTableWidget* metricsTable;
     QTableWidget* syncTable;
     QLabel* statusLabel;
+    QPushButton* kernelBtn = nullptr;
+    QThread* kernelThread = nullptr; // ejecución en el kernel en curso
 
     void setupMultiSelectionWidget();
     void setupSequentialSimWidget();
@@ -106,6 +110,7 @@ private:
 
     // Process management
     void loadProcessesFromDialog();
+    void importSchedTraceFromDialog();
     void generateSampleProcesses();
     void generateSampleResources();
     void updateProcessTable();
@@ -117,6 +122,7 @@ private:
     void runSRTF();
     void runRoundRobin();
     void runPriority();
+    void runOnKernel(int quantum);
 
     // Synchronization
     void startMainAnimation();
@@ -0,0 +1,266 @@
+#include "schedtrace.h"
+#include "loader.h"
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+// Ráfagas terminadas que se retienen esperando a una abierta más antigua;
+// pasado el límite se entregan aunque salgan algo desordenadas
+constexpr size_t kMaxPending = 1 << 20;
+
+const QString kSwitch = "sched_switch:";
+const QString kWakeupNew = "sched_wakeup_new:";
+const QString kWakeup = "sched_wakeup:";
+
+// Desde el final de `key` hasta el siguiente espacio (o hasta `until`)
+bool field(const QString& line, int from, const QString& key, QString& value, const QString& until = QString()) {
+    int start = line.indexOf(key, from);
+    if (start < 0) return false;
+    start += key.size();
+    int end = line.indexOf(until.isEmpty() ? QString(" ") : until, start);
+    value = line.mid(start, end < 0 ? -1 : end - start);
+    return true;
+}
+
+bool intField(const QString& line, int from, const QString& key, int& value) {
+    QString text;
+    bool ok = false;
+    if (field(line, from, key, text)) {
+        value = text.toInt(&ok);
+    }
+    return ok;
+}
+
+// "sched:sched_switch:" en perf, "sched_switch:" en ftrace: inicio del token
+int tokenStart(const QString& line, int pos) {
+    while (pos > 0 && !line.at(pos - 1).isSpace()) pos--;
+    return pos;
+}
+
+// Marca "segundos.micros:" justo antes del nombre del evento, en microsegundos
+bool timestampBefore(const QString& line, int event, long long& us) {
+    int end = event - 1;
+    while (end >= 0 && line.at(end).isSpace()) end--;
+    if (end < 0 || line.at(end) != QChar(':')) return false;
+    int start = tokenStart(line, end);
+    bool ok = false;
+    double seconds = line.mid(start, end - start).toDouble(&ok);
+    if (!ok) return false;
+    us = std::llround(seconds * 1e6);
+    return true;
+}
+
+} // namespace
+
+SchedTraceImporter::SchedTraceImporter(const SchedTraceOptions& trace_options, Sink process_sink)
+    : options(trace_options), sink(std::move(process_sink)) {
+    options.tick_us = std::max(options.tick_us, 1);
+}
+
+SchedTraceImporter::Task& SchedTraceImporter::touch(int pid, const QString& comm, int priority, long long now) {
+    auto found = tasks.find(pid);
+    if (found == tasks.end()) {
+        found = tasks.emplace(pid, Task()).first;
+        Task& task = found->second;
+        // Sin comas: el nombre acaba en un archivo de procesos separado por comas
+        task.name = QString(comm).replace(",", "_") + "-" + QString::number(pid);
+        task.first_seen = now;
+        counters.tasks++;
+    }
+    found->second.priority = priority;
+    return found->second;
+}
+
+void SchedTraceImporter::openBurst(Task& task, long long now) {
+    if (options.mode != SchedTraceMode::PER_BURST || task.burst_arrival >= 0) return;
+    task.burst_arrival = now;
+    task.burst_runtime = 0;
+    open_arrivals[now]++;
+}
+
+void SchedTraceImporter::closeBurst(Task& task) {
+    if (task.burst_arrival < 0) return;
+    auto open = open_arrivals.find(task.burst_arrival);
+    if (--open->second == 0) {
+        open_arrivals.erase(open);
+    }
+    if (task.burst_runtime > 0) {
+        emitProcess(task.name + "#" + QString::number(++task.bursts), task.burst_runtime,
+                    task.burst_arrival, task.priority);
+    }
+    task.burst_arrival = -1;
+    flush(false);
+}
+
+void SchedTraceImporter::stopRunning(Task& task, long long now) {
+    if (task.running_since < 0) return;
+    long long ran = std::max(0LL, now - task.running_since);
+    task.runtime += ran;
+    if (task.burst_arrival >= 0) {
+        task.burst_runtime += ran;
+    }
+    task.running_since = -1;
+}
+
+void SchedTraceImporter::emitProcess(const QString& name, long long runtime, long long arrival, int priority) {
+    Process process;
+    process.pid = name;
+    process.burst_time = static_cast<int>(std::max(1LL, (runtime + options.tick_us / 2) / options.tick_us));
+    process.arrival_time = static_cast<int>((arrival - origin) / options.tick_us);
+    process.priority = priority;
+    process.remaining_time = process.burst_time;
+    ready.push(Pending{arrival, seq++, process});
+}
+
+// Entrega lo que ya no puede adelantarse nadie: llegadas hasta la ráfaga abierta más antigua
+void SchedTraceImporter::flush(bool all) {
+    const long long watermark = all || open_arrivals.empty() ? LLONG_MAX : open_arrivals.begin()->first;
+    while (!ready.empty() && (ready.top().arrival <= watermark || ready.size() > kMaxPending)) {
+        sink(ready.top().process);
+        counters.processes++;
+        ready.pop();
+    }
+}
+
+void SchedTraceImporter::addLine(const QString& line) {
+    counters.lines++;
+    int event = line.indexOf(kSwitch);
+    const bool is_switch = event >= 0;
+    if (!is_switch) {
+        event = line.indexOf(kWakeupNew);
+        if (event < 0) event = line.indexOf(kWakeup);
+        if (event < 0) return;
+    }
+
+    long long now = 0;
+    if (!timestampBefore(line, tokenStart(line, event), now)) {
+        counters.unparsed++;
+        return;
+    }
+    if (origin < 0) origin = now;
+    last_time = std::max(last_time, now);
+    counters.span_us = last_time - origin;
+
+    if (is_switch) {
+        // prev_comm=... prev_pid=N prev_prio=N prev_state=S ==> next_comm=... next_pid=N next_prio=N
+        QString prev_comm, prev_state, next_comm;
+        int prev_pid = 0, prev_prio = 0, next_pid = 0, next_prio = 0;
+        if (!field(line, event, "prev_comm=", prev_comm, " prev_pid=")
+            || !intField(line, event, " prev_pid=", prev_pid)
+            || !intField(line, event, " prev_prio=", prev_prio)
+            || !field(line, event, " prev_state=", prev_state)
+            || !field(line, event, "next_comm=", next_comm, " next_pid=")
+            || !intField(line, event, " next_pid=", next_pid)
+            || !intField(line, event, " next_prio=", next_prio)) {
+            counters.unparsed++;
+            return;
+        }
+        counters.events++;
+        // pid 0 es la tarea ociosa de cada CPU
+        if (prev_pid != 0) {
+            Task& prev = touch(prev_pid, prev_comm, prev_prio, now);
+            stopRunning(prev, now);
+            // R / R+: expropiada, sigue lista y la ráfaga continúa
+            if (!prev_state.startsWith("R")) {
+                closeBurst(prev);
+            }
+        }
+        if (next_pid != 0) {
+            Task& next = touch(next_pid, next_comm, next_prio, now);
+            openBurst(next, now); // corría ya al empezar la traza: llega aquí
+            next.running_since = now;
+        }
+        return;
+    }
+
+    // comm=... pid=N prio=N target_cpu=N
+    QString comm;
+    int pid = 0, prio = 0;
+    if (!field(line, event, "comm=", comm, " pid=")
+        || !intField(line, event, " pid=", pid)
+        || !intField(line, event, " prio=", prio)) {
+        counters.unparsed++;
+        return;
+    }
+    counters.events++;
+    if (pid != 0) {
+        openBurst(touch(pid, comm, prio, now), now);
+    }
+}
+
+void SchedTraceImporter::finish() {
+    for (auto& entry : tasks) {
+        Task& task = entry.second;
+        stopRunning(task, last_time);
+        if (options.mode == SchedTraceMode::PER_BURST) {
+            closeBurst(task);
+        } else if (task.runtime > 0) {
+            emitProcess(task.name, task.runtime, task.first_seen, task.priority);
+        }
+    }
+    flush(true);
+}
+
+SchedTraceStats convertSchedTrace(const QString& input, const QString& output, const SchedTraceOptions& options) {
+    QFile in_file(input);
+    if (!in_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open file:" << input;
+        return SchedTraceStats();
+    }
+    QFile out_file(output);
+    if (!out_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open file:" << output;
+        return SchedTraceStats();
+    }
+
+    QTextStream in(&in_file);
+    QTextStream out(&out_file);
+    out << "# pid, burst, arrival, priority (" << input << ", tick " << options.tick_us << " us)\n";
+    SchedTraceImporter importer(options, [&out](const Process& p) {
+        out << p.pid << ", " << p.burst_time << ", " << p.arrival_time << ", " << p.priority << "\n";
+    });
+    QString line;
+    while (in.readLineInto(&line)) {
+        importer.addLine(line);
+    }
+    importer.finish();
+
+    const SchedTraceStats& stats = importer.stats();
+    if (stats.unparsed > 0) {
+        qDebug() << "Skipped" << stats.unparsed << "unreadable sched events in" << input;
+    }
+    return stats;
+}
+
+std::vector<Process> loadSchedTrace(const QString& input, const SchedTraceOptions& options, SchedTraceStats* stats) {
+    std::vector<Process> processes;
+    QFile file(input);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open file:" << input;
+        return processes;
+    }
+
+    QTextStream in(&file);
+    SchedTraceImporter importer(options, [&processes](const Process& p) {
+        processes.push_back(p);
+        processes.back().color = processColor(static_cast<int>(processes.size()) - 1);
+    });
+    QString line;
+    while (in.readLineInto(&line)) {
+        importer.addLine(line);
+    }
+    importer.finish();
+
+    if (importer.stats().unparsed > 0) {
+        qDebug() << "Skipped" << importer.stats().unparsed << "unreadable sched events in" << input;
+    }
+    if (stats) {
+        *stats = importer.stats();
+    }
+    return processes;
+}
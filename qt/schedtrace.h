@@ -0,0 +1,95 @@
+#ifndef SCHEDTRACE_H
+#define SCHEDTRACE_H
+
+#include "utils.h"
+#include <QString>
+#include <functional>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+// Cómo se convierte cada tarea del kernel en procesos del simulador
+enum class SchedTraceMode {
+    PER_TASK,  // un proceso por tarea: primera aparición y todo su tiempo de CPU
+    PER_BURST  // un proceso por ráfaga: de cada despertar hasta que vuelve a dormir
+};
+
+struct SchedTraceOptions {
+    SchedTraceMode mode = SchedTraceMode::PER_BURST;
+    int tick_us = 1000; // microsegundos de traza por unidad de tiempo del simulador
+};
+
+struct SchedTraceStats {
+    long long lines = 0;
+    long long events = 0;     // sched_switch / sched_wakeup reconocidos
+    long long unparsed = 0;   // líneas con evento sched_* que no se pudieron leer
+    int tasks = 0;
+    long long processes = 0;  // procesos emitidos
+    long long span_us = 0;    // del primer al último evento
+};
+
+// Lee volcados de texto de `perf sched script` o de ftrace (eventos
+// sched_switch, sched_wakeup, sched_wakeup_new) línea a línea y entrega los
+// procesos por `sink` en orden de llegada. Solo guarda el estado de cada
+// tarea y las ráfagas terminadas que aún pueden adelantarse a una abierta,
+// así que la memoria no crece con el tamaño del volcado.
+// Llegada y ráfaga en ticks desde el primer evento; la prioridad es la del
+// kernel (prio: 0-99 tiempo real, 100-139 normal; menor = más prioritaria).
+class SchedTraceImporter {
+public:
+    using Sink = std::function<void(const Process&)>;
+
+    SchedTraceImporter(const SchedTraceOptions& options, Sink sink);
+    void addLine(const QString& line);
+    // Cierra lo que sigue abierto al final de la traza y vacía la cola
+    void finish();
+    const SchedTraceStats& stats() const { return counters; }
+
+private:
+    struct Task {
+        QString name;                 // comm-pid
+        int priority = 0;
+        long long first_seen = 0;     // us
+        long long runtime = 0;        // us en CPU en total
+        long long running_since = -1; // us; -1 si no está en CPU
+        long long burst_arrival = -1; // us; -1 sin ráfaga abierta
+        long long burst_runtime = 0;
+        int bursts = 0;
+    };
+    struct Pending {
+        long long arrival;
+        long long seq;
+        Process process;
+        bool operator>(const Pending& other) const {
+            return arrival != other.arrival ? arrival > other.arrival : seq > other.seq;
+        }
+    };
+
+    Task& touch(int pid, const QString& comm, int priority, long long now);
+    void openBurst(Task& task, long long now);
+    void closeBurst(Task& task);
+    void stopRunning(Task& task, long long now);
+    void emitProcess(const QString& name, long long runtime, long long arrival, int priority);
+    void flush(bool all);
+
+    SchedTraceOptions options;
+    Sink sink;
+    SchedTraceStats counters;
+    std::unordered_map<int, Task> tasks;
+    std::map<long long, int> open_arrivals; // llegadas de ráfagas abiertas -> cuántas
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> ready;
+    long long origin = -1;
+    long long last_time = 0;
+    long long seq = 0;
+};
+
+// Convierte `input` en un archivo de procesos ("pid, burst, arrival,
+// priority") que loadProcesses o ProcessStream pueden leer
+SchedTraceStats convertSchedTrace(const QString& input, const QString& output,
+                                  const SchedTraceOptions& options = SchedTraceOptions());
+std::vector<Process> loadSchedTrace(const QString& input,
+                                    const SchedTraceOptions& options = SchedTraceOptions(),
+                                    SchedTraceStats* stats = nullptr);
+
+#endif
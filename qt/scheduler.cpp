@@ -1,10 +1,45 @@
 #include "scheduler.h"
+#include "loader.h"
+#include "timingwheel.h"
 #include <algorithm>
 #include <queue>
 #include <map>
+#include <deque>
+
+namespace {
+
+// Llegadas pendientes de las versiones con vector, en una rueda de tiempos:
+// admitir solo mira lo que vence y, sin procesos listos, el reloj salta a la
+// siguiente llegada en vez de avanzar de uno en uno
+class ArrivalQueue {
+private:
+    TimingWheel<int> wheel;
+    std::vector<int> due;
+
+public:
+    explicit ArrivalQueue(const std::vector<Process>& processes) {
+        for (size_t i = 0; i < processes.size(); i++) {
+            wheel.push(std::max(processes[i].arrival_time, 0), static_cast<int>(i));
+        }
+    }
+
+    bool empty() const { return wheel.empty(); }
+    int next() const { return static_cast<int>(wheel.nextTime()); }
+
+    // Índices de los llegados hasta `time`, en el orden del vector de entrada
+    const std::vector<int>& admit(int time) {
+        due.clear();
+        wheel.popUntil(time, due);
+        std::sort(due.begin(), due.end());
+        return due;
+    }
+};
+
+} // namespace
 
 std::vector<ExecutionSlice> SchedulingAlgorithms::runFIFO(std::vector<Process>& processes) {
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
+    // Estable: a igual llegada, en el orden del vector, como los demás algoritmos
+    std::stable_sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
         return a.arrival_time < b.arrival_time;
     });
 
@@ -28,20 +63,15 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runFIFO(std::vector<Process>&
 
 std::vector<ExecutionSlice> SchedulingAlgorithms::runSJF(std::vector<Process>& processes) {
     std::vector<ExecutionSlice> timeline;
-    std::vector<Process> remaining = processes;
+    ArrivalQueue arrivals(processes);
     std::vector<Process> ready_queue;
     std::vector<Process> executed;
     int currentTime = 0;
 
-    while (!remaining.empty() || !ready_queue.empty()) {
+    while (!arrivals.empty() || !ready_queue.empty()) {
         // Add arrived processes to ready queue
-        for (auto it = remaining.begin(); it != remaining.end();) {
-            if (it->arrival_time <= currentTime) {
-                ready_queue.push_back(*it);
-                it = remaining.erase(it);
-            } else {
-                ++it;
-            }
+        for (int i : arrivals.admit(currentTime)) {
+            ready_queue.push_back(processes[i]);
         }
 
         if (!ready_queue.empty()) {
@@ -63,7 +93,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runSJF(std::vector<Process>& p
             currentTime = current.finish_time;
             executed.push_back(current);
         } else {
-            currentTime++;
+            currentTime = arrivals.next();
         }
     }
 
@@ -73,7 +103,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runSJF(std::vector<Process>& p
 
 std::vector<ExecutionSlice> SchedulingAlgorithms::runSRT(std::vector<Process>& processes) {
     std::vector<ExecutionSlice> timeline;
-    std::vector<Process> remaining = processes;
+    ArrivalQueue arrivals(processes);
     std::vector<Process> ready_queue;
     std::map<QString, int> remaining_bt;
     std::map<QString, int> start_times;
@@ -85,15 +115,10 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runSRT(std::vector<Process>& p
         remaining_bt[p.pid] = p.burst_time;
     }
 
-    while (!ready_queue.empty() || !remaining.empty()) {
+    while (!ready_queue.empty() || !arrivals.empty()) {
         // Add arrived processes
-        for (auto it = remaining.begin(); it != remaining.end();) {
-            if (it->arrival_time <= currentTime) {
-                ready_queue.push_back(*it);
-                it = remaining.erase(it);
-            } else {
-                ++it;
-            }
+        for (int i : arrivals.admit(currentTime)) {
+            ready_queue.push_back(processes[i]);
         }
 
         if (!ready_queue.empty()) {
@@ -110,10 +135,18 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runSRT(std::vector<Process>& p
                 start_times[current.pid] = currentTime;
             }
 
-            // Execute for 1 time unit
-            timeline.push_back(ExecutionSlice(current.pid, currentTime, 1, current.color));
-            currentTime++;
-            remaining_bt[current.pid]--;
+            // Hasta la próxima llegada nadie le quita el turno: su tiempo
+            // restante solo baja. Se sigue anotando en slices de 1 unidad.
+            int run = remaining_bt[current.pid];
+            if (!arrivals.empty()) {
+                run = std::min(run, arrivals.next() - currentTime);
+            }
+            run = std::max(run, 1);
+            for (int tick = 0; tick < run; tick++) {
+                timeline.push_back(ExecutionSlice(current.pid, currentTime + tick, 1, current.color));
+            }
+            currentTime += run;
+            remaining_bt[current.pid] -= run;
 
             // Check if process is complete
             if (remaining_bt[current.pid] == 0) {
@@ -124,7 +157,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runSRT(std::vector<Process>& p
                 ready_queue.erase(shortest);
             }
         } else {
-            currentTime++;
+            currentTime = arrivals.next();
         }
     }
 
@@ -135,7 +168,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runSRT(std::vector<Process>& p
 std::vector<ExecutionSlice> SchedulingAlgorithms::runRoundRobin(std::vector<Process>& processes, int quantum) {
     std::vector<ExecutionSlice> timeline;
     std::queue<Process> ready_queue;
-    std::vector<Process> remaining = processes;
+    ArrivalQueue arrivals(processes);
     std::map<QString, int> remaining_bt;
     std::map<QString, int> start_times;
     std::vector<Process> executed;
@@ -145,15 +178,10 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runRoundRobin(std::vector<Proc
         remaining_bt[p.pid] = p.burst_time;
     }
 
-    while (!ready_queue.empty() || !remaining.empty()) {
+    while (!ready_queue.empty() || !arrivals.empty()) {
         // Add arrived processes
-        for (auto it = remaining.begin(); it != remaining.end();) {
-            if (it->arrival_time <= currentTime) {
-                ready_queue.push(*it);
-                it = remaining.erase(it);
-            } else {
-                ++it;
-            }
+        for (int i : arrivals.admit(currentTime)) {
+            ready_queue.push(processes[i]);
         }
 
         if (!ready_queue.empty()) {
@@ -171,13 +199,8 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runRoundRobin(std::vector<Proc
             remaining_bt[current.pid] -= exec_time;
 
             // Add new arrivals
-            for (auto it = remaining.begin(); it != remaining.end();) {
-                if (it->arrival_time <= currentTime) {
-                    ready_queue.push(*it);
-                    it = remaining.erase(it);
-                } else {
-                    ++it;
-                }
+            for (int i : arrivals.admit(currentTime)) {
+                ready_queue.push(processes[i]);
             }
 
             if (remaining_bt[current.pid] > 0) {
@@ -189,7 +212,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runRoundRobin(std::vector<Proc
                 executed.push_back(current);
             }
         } else {
-            currentTime++;
+            currentTime = arrivals.next();
         }
     }
 
@@ -199,7 +222,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runRoundRobin(std::vector<Proc
 
 std::vector<ExecutionSlice> SchedulingAlgorithms::runPriority(std::vector<Process>& processes, bool agingEnabled, int agingInterval) {
     std::vector<ExecutionSlice> timeline;
-    std::vector<Process> remaining = processes;
+    ArrivalQueue arrivals(processes);
     std::vector<Process> ready_queue;
     std::map<QString, int> wait_time;
     std::vector<Process> executed;
@@ -210,15 +233,10 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runPriority(std::vector<Proces
         wait_time[p.pid] = 0;
     }
 
-    while (!remaining.empty() || !ready_queue.empty()) {
+    while (!arrivals.empty() || !ready_queue.empty()) {
         // Añadir procesos que han llegado
-        for (auto it = remaining.begin(); it != remaining.end();) {
-            if (it->arrival_time <= currentTime) {
-                ready_queue.push_back(*it);
-                it = remaining.erase(it);
-            } else {
-                ++it;
-            }
+        for (int i : arrivals.admit(currentTime)) {
+            ready_queue.push_back(processes[i]);
         }
 
         // Si hay procesos listos
@@ -254,7 +272,7 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runPriority(std::vector<Proces
             executed.push_back(current);
             wait_time.erase(current.pid); 
         } else {
-            currentTime++;
+            currentTime = arrivals.next();
         }
     }
 
@@ -262,6 +280,224 @@ std::vector<ExecutionSlice> SchedulingAlgorithms::runPriority(std::vector<Proces
     return timeline;
 }
 
+// ================================
+// STREAMING
+// ================================
+
+namespace {
+
+// Proceso en la cola de listos; `seq` es el orden de admisión y desempata igual
+// que el orden de la cola en las versiones con vector.
+struct ReadyEntry {
+    Process process;
+    long long seq;
+    int remaining;
+    int start;
+    long long admitted; // despacho en que entró (envejecimiento de Priority)
+};
+
+struct ShortestFirst {
+    bool operator()(const ReadyEntry& a, const ReadyEntry& b) const {
+        if (a.remaining != b.remaining) return a.remaining > b.remaining;
+        return a.seq > b.seq;
+    }
+};
+
+ReadyEntry makeEntry(const Process& p, long long seq) {
+    return ReadyEntry{p, seq, p.burst_time, -1, 0};
+}
+
+} // namespace
+
+void SchedulingAlgorithms::runFIFO(ProcessStream& source, const SliceSink& onSlice, const ProcessSink& onFinish) {
+    int currentTime = 0;
+
+    while (source.hasNext()) {
+        Process p = source.next();
+        if (currentTime < p.arrival_time) {
+            currentTime = p.arrival_time;
+        }
+        p.start_time = currentTime;
+        p.finish_time = currentTime + p.burst_time;
+        p.waiting_time = p.start_time - p.arrival_time;
+
+        onSlice(ExecutionSlice(p.pid, currentTime, p.burst_time, p.color));
+        onFinish(p);
+        currentTime += p.burst_time;
+    }
+}
+
+void SchedulingAlgorithms::runSJF(ProcessStream& source, const SliceSink& onSlice, const ProcessSink& onFinish) {
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, ShortestFirst> ready_queue;
+    long long seq = 0;
+    int currentTime = 0;
+
+    while (source.hasNext() || !ready_queue.empty()) {
+        // Sin procesos listos: saltar directo a la siguiente llegada
+        if (ready_queue.empty() && source.peek().arrival_time > currentTime) {
+            currentTime = source.peek().arrival_time;
+        }
+        while (source.hasNext() && source.peek().arrival_time <= currentTime) {
+            ready_queue.push(makeEntry(source.next(), seq++));
+        }
+
+        Process current = ready_queue.top().process;
+        ready_queue.pop();
+
+        current.start_time = currentTime;
+        current.finish_time = currentTime + current.burst_time;
+        current.waiting_time = current.start_time - current.arrival_time;
+
+        onSlice(ExecutionSlice(current.pid, currentTime, current.burst_time, current.color));
+        onFinish(current);
+        currentTime = current.finish_time;
+    }
+}
+
+void SchedulingAlgorithms::runSRT(ProcessStream& source, const SliceSink& onSlice, const ProcessSink& onFinish) {
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, ShortestFirst> ready_queue;
+    long long seq = 0;
+    int currentTime = 0;
+
+    while (source.hasNext() || !ready_queue.empty()) {
+        if (ready_queue.empty() && source.peek().arrival_time > currentTime) {
+            currentTime = source.peek().arrival_time;
+        }
+        while (source.hasNext() && source.peek().arrival_time <= currentTime) {
+            ready_queue.push(makeEntry(source.next(), seq++));
+        }
+
+        // Ejecutar 1 unidad de tiempo del de menor tiempo restante
+        ReadyEntry current = ready_queue.top();
+        ready_queue.pop();
+        if (current.start < 0) {
+            current.start = currentTime;
+        }
+
+        onSlice(ExecutionSlice(current.process.pid, currentTime, 1, current.process.color));
+        currentTime++;
+        current.remaining--;
+
+        if (current.remaining == 0) {
+            Process& p = current.process;
+            p.start_time = current.start;
+            p.finish_time = currentTime;
+            p.waiting_time = p.finish_time - p.arrival_time - p.burst_time;
+            onFinish(p);
+        } else {
+            ready_queue.push(current);
+        }
+    }
+}
+
+void SchedulingAlgorithms::runRoundRobin(ProcessStream& source, int quantum,
+                                         const SliceSink& onSlice, const ProcessSink& onFinish) {
+    std::deque<ReadyEntry> ready_queue;
+    long long seq = 0;
+    int currentTime = 0;
+
+    auto admitArrived = [&]() {
+        while (source.hasNext() && source.peek().arrival_time <= currentTime) {
+            ready_queue.push_back(makeEntry(source.next(), seq++));
+        }
+    };
+
+    while (source.hasNext() || !ready_queue.empty()) {
+        if (ready_queue.empty() && source.peek().arrival_time > currentTime) {
+            currentTime = source.peek().arrival_time;
+        }
+        admitArrived();
+
+        ReadyEntry current = ready_queue.front();
+        ready_queue.pop_front();
+        if (current.start < 0) {
+            current.start = currentTime;
+        }
+
+        int exec_time = std::min(quantum, current.remaining);
+        onSlice(ExecutionSlice(current.process.pid, currentTime, exec_time, current.process.color));
+
+        currentTime += exec_time;
+        current.remaining -= exec_time;
+
+        // Las llegadas durante el quantum entran antes que el proceso desalojado
+        admitArrived();
+
+        if (current.remaining > 0) {
+            ready_queue.push_back(current);
+        } else {
+            Process& p = current.process;
+            p.finish_time = currentTime;
+            p.waiting_time = (p.finish_time - p.arrival_time) - p.burst_time;
+            p.start_time = current.start;
+            onFinish(p);
+        }
+    }
+}
+
+void SchedulingAlgorithms::runPriority(ProcessStream& source, bool agingEnabled, int agingInterval,
+                                       const SliceSink& onSlice, const ProcessSink& onFinish) {
+    // Una cola FIFO por prioridad original. El envejecimiento es implícito:
+    // en el despacho `dispatch` un proceso admitido en el despacho `admitted`
+    // lleva dispatch − admitted + 1 despachos esperando, así que su prioridad es
+    // la original menos una por cada agingInterval (sin bajar de 1). Dentro de
+    // una cola todos pierden prioridad al mismo ritmo y el primero es el más
+    // antiguo, de modo que basta mirar el frente de cada cola: cada despacho
+    // cuesta O(prioridades distintas en espera), no O(listos).
+    std::map<int, std::deque<ReadyEntry>> ready_queues;
+    const bool aging = agingEnabled && agingInterval > 0;
+    long long seq = 0;
+    long long dispatch = 0;
+    int currentTime = 0;
+
+    auto agedPriority = [&](const ReadyEntry& entry) {
+        const int priority = entry.process.priority;
+        if (!aging || priority <= 1) return priority;
+        const long long waited = dispatch - entry.admitted + 1;
+        return static_cast<int>(std::max(1LL, priority - waited / agingInterval));
+    };
+
+    while (source.hasNext() || !ready_queues.empty()) {
+        if (ready_queues.empty() && source.peek().arrival_time > currentTime) {
+            currentTime = source.peek().arrival_time;
+        }
+        while (source.hasNext() && source.peek().arrival_time <= currentTime) {
+            ReadyEntry entry = makeEntry(source.next(), seq++);
+            entry.admitted = dispatch;
+            ready_queues[entry.process.priority].push_back(entry);
+        }
+
+        // Menor prioridad envejecida; a igualdad, el admitido antes
+        auto highest = ready_queues.end();
+        int best_priority = 0;
+        for (auto it = ready_queues.begin(); it != ready_queues.end(); ++it) {
+            const ReadyEntry& front = it->second.front();
+            const int priority = agedPriority(front);
+            if (highest == ready_queues.end() || priority < best_priority ||
+                (priority == best_priority && front.seq < highest->second.front().seq)) {
+                highest = it;
+                best_priority = priority;
+            }
+        }
+
+        Process current = highest->second.front().process;
+        highest->second.pop_front();
+        if (highest->second.empty()) {
+            ready_queues.erase(highest);
+        }
+        dispatch++;
+
+        current.priority = best_priority;
+        current.start_time = currentTime;
+        current.finish_time = currentTime + current.burst_time;
+        current.waiting_time = current.start_time - current.arrival_time;
+
+        onSlice(ExecutionSlice(current.pid, currentTime, current.burst_time, current.color));
+        onFinish(current);
+        currentTime = current.finish_time;
+    }
+}
+
 double SchedulingAlgorithms::calculateAverageWaitingTime(const std::vector<Process>& processes) {
     if (processes.empty()) return 0.0;
     
@@ -3,15 +3,34 @@
 
 #include "utils.h"
 #include <vector>
+#include <functional>
+
+class ProcessStream;
 
 class SchedulingAlgorithms {
 public:
+    using SliceSink = std::function<void(const ExecutionSlice&)>;
+    using ProcessSink = std::function<void(const Process&)>;
+
     static std::vector<ExecutionSlice> runFIFO(std::vector<Process>& processes);
     static std::vector<ExecutionSlice> runSJF(std::vector<Process>& processes); 
     static std::vector<ExecutionSlice> runSRT(std::vector<Process>& processes);
     static std::vector<ExecutionSlice> runRoundRobin(std::vector<Process>& processes, int quantum);
     static std::vector<ExecutionSlice> runPriority(std::vector<Process>& processes, bool agingEnabled, int agingInterval = 5);
 
+    // Variantes en streaming: toman procesos de `source` a medida que avanza el tiempo
+    // simulado y entregan cada slice y cada proceso terminado a los sinks.
+    // Cada despacho cuesta O(log listos); en Priority, O(prioridades distintas
+    // en espera). Los tiempos son int, así que el reloj simulado (la suma de
+    // ráfagas y huecos) no puede pasar de INT_MAX: unos 4·10^8 procesos de
+    // ráfaga media 5, no 10^9.
+    static void runFIFO(ProcessStream& source, const SliceSink& onSlice, const ProcessSink& onFinish);
+    static void runSJF(ProcessStream& source, const SliceSink& onSlice, const ProcessSink& onFinish);
+    static void runSRT(ProcessStream& source, const SliceSink& onSlice, const ProcessSink& onFinish);
+    static void runRoundRobin(ProcessStream& source, int quantum, const SliceSink& onSlice, const ProcessSink& onFinish);
+    static void runPriority(ProcessStream& source, bool agingEnabled, int agingInterval,
+                            const SliceSink& onSlice, const ProcessSink& onFinish);
+
     static double calculateAverageWaitingTime(const std::vector<Process>& processes);
     static double calculateAverageCompletionTime(const std::vector<Process>& processes);
 };
@@ -20,7 +20,10 @@
 #include <QResizeEvent>
 #include <QDebug>
 #include <QScrollBar>
+#include <QThread>
+#include <QStringList>
 #include <climits>
+#include <memory>
 #include <QGraphicsDropShadowEffect>
 
 SynchronizationSimulatorWidget::SynchronizationSimulatorWidget(QStackedWidget* mainStack, QWidget* menuWidget, QWidget *parent)
@@ -34,6 +37,11 @@ SynchronizationSimulatorWidget::SynchronizationSimulatorWidget(QStackedWidget* m
 
 SynchronizationSimulatorWidget::~SynchronizationSimulatorWidget()
 {
+    // La reproducción acaba sola al vencer el último ciclo de la traza
+    if (replayThread) {
+        replayThread->wait();
+        delete replayThread;
+    }
     delete syncMechanism;
 }
 
@@ -82,19 +90,59 @@ void SynchronizationSimulatorWidget::setupUI()
     );
     syncTypeCombo->setMaximumHeight(30);
 
+    // Política lector/escritor del semáforo (mismo orden que RWPolicy)
+    rwPolicyCombo = new QComboBox();
+    rwPolicyCombo->addItems({"Preferencia lectores", "Preferencia escritores", "Fase justa"});
+    rwPolicyCombo->setStyleSheet(syncTypeCombo->styleSheet());
+    rwPolicyCombo->setMaximumHeight(30);
+
+    // Orden de las colas del mutex: FIFO o por prioridad (índice - 1 = PriorityProtocol)
+    priorityCombo = new QComboBox();
+    priorityCombo->addItems({"FIFO", "Prioridad", "Herencia de prioridad", "Techo de prioridad"});
+    priorityCombo->setStyleSheet(syncTypeCombo->styleSheet());
+    priorityCombo->setMaximumHeight(30);
+
+    // Implementación de cerrojo para el modelo de costes (mismo orden que LockKind)
+    lockKindCombo = new QComboBox();
+    lockKindCombo->addItems({"Ticket", "MCS", "Girar y dormir"});
+    lockKindCombo->setStyleSheet(syncTypeCombo->styleSheet());
+    lockKindCombo->setMaximumHeight(30);
+
+    // Primitiva real para la ejecución con hilos (mismo orden que ReplayPrimitive)
+    replayCombo = new QComboBox();
+    replayCombo->addItems({"std::mutex", "std::shared_mutex", "Semáforo POSIX"});
+    replayCombo->setStyleSheet(syncTypeCombo->styleSheet());
+    replayCombo->setMaximumHeight(30);
+
+    loadProcBtn = createButton("Cargar Procesos", "#fd7e14");
     loadResBtn = createButton("Cargar Recursos", "#70a1a8");
     loadActBtn = createButton("Cargar Acciones", "#28a745");
     QPushButton *runMutexBtn = createButton("Simular Mutex", "#dc3545");
     QPushButton *runSemBtn = createButton("Simular Semáforo", "#ffc107");
+    QPushButton *runBankerBtn = createButton("Simular Banquero", "#6f42c1");
+    QPushButton *runCostBtn = createButton("Simular Costes", "#20c997");
+    QPushButton *runRcuBtn = createButton("Simular RCU", "#e83e8c");
+    QPushButton *runSeqBtn = createButton("Simular Seqlock", "#6610f2");
+    replayBtn = createButton("Ejecutar con hilos", "#343a40");
     QPushButton *clearBtn = createButton("Limpiar", "#6c757d");
     QPushButton *infoBtn = createButton("Mostrar Info", "#17a2b8");
 
     controlLayout->addWidget(typeLabel);
     controlLayout->addWidget(syncTypeCombo);
+    controlLayout->addWidget(rwPolicyCombo);
+    controlLayout->addWidget(priorityCombo);
+    controlLayout->addWidget(loadProcBtn);
     controlLayout->addWidget(loadResBtn);
     controlLayout->addWidget(loadActBtn);
     controlLayout->addWidget(runMutexBtn);
     controlLayout->addWidget(runSemBtn);
+    controlLayout->addWidget(runBankerBtn);
+    controlLayout->addWidget(lockKindCombo);
+    controlLayout->addWidget(runCostBtn);
+    controlLayout->addWidget(runRcuBtn);
+    controlLayout->addWidget(runSeqBtn);
+    controlLayout->addWidget(replayCombo);
+    controlLayout->addWidget(replayBtn);
     controlLayout->addWidget(clearBtn);
     controlLayout->addWidget(infoBtn);
     controlLayout->addStretch();
@@ -195,8 +243,8 @@ void SynchronizationSimulatorWidget::setupUI()
     eventsLayout->setContentsMargins(6, 12, 6, 6);
     
     syncTable = new QTableWidget();
-    syncTable->setColumnCount(5);
-    syncTable->setHorizontalHeaderLabels({"Proceso", "Estado", "Recurso", "Acción", "Ciclo"});
+    syncTable->setColumnCount(6);
+    syncTable->setHorizontalHeaderLabels({"Proceso", "Estado", "Recurso", "Acción", "Ciclo", "Medido"});
     
     syncTable->setMinimumHeight(520);
     syncTable->setStyleSheet(
@@ -239,6 +287,7 @@ void SynchronizationSimulatorWidget::setupUI()
     syncTable->setColumnWidth(1, 70);
     syncTable->setColumnWidth(2, 60);
     syncTable->setColumnWidth(3, 60);
+    syncTable->setColumnWidth(4, 60);
     
     eventsLayout->addWidget(syncTable);
     leftLayout->addWidget(eventsGroup);
@@ -360,9 +409,15 @@ void SynchronizationSimulatorWidget::setupUI()
             loadResourcesFromDialog();
         }
     });
+    connect(loadProcBtn, &QPushButton::clicked, this, &SynchronizationSimulatorWidget::loadProcessesFromDialog);
     connect(loadActBtn, &QPushButton::clicked, this, &SynchronizationSimulatorWidget::loadActionsFromDialog);
     connect(runMutexBtn, &QPushButton::clicked, [this]() { runSynchronization("Mutex Lock"); });
     connect(runSemBtn, &QPushButton::clicked, [this]() { runSynchronization("Semaphore"); });
+    connect(runBankerBtn, &QPushButton::clicked, [this]() { runSynchronization("Banker"); });
+    connect(runCostBtn, &QPushButton::clicked, [this]() { runSynchronization("Lock Cost"); });
+    connect(runRcuBtn, &QPushButton::clicked, [this]() { runSynchronization("RCU"); });
+    connect(runSeqBtn, &QPushButton::clicked, [this]() { runSynchronization("Seqlock"); });
+    connect(replayBtn, &QPushButton::clicked, this, &SynchronizationSimulatorWidget::runThreadReplay);
     connect(clearBtn, &QPushButton::clicked, this, &SynchronizationSimulatorWidget::clearAll);
     connect(infoBtn, &QPushButton::clicked, this, &SynchronizationSimulatorWidget::showInfo);
     
@@ -409,9 +464,15 @@ void SynchronizationSimulatorWidget::onSyncTypeChanged()
 
     if (currentSyncType == "Mutex") {
         loadResBtn->setVisible(false);
+        rwPolicyCombo->setVisible(false);
+        priorityCombo->setVisible(true);
+        loadProcBtn->setVisible(true);
         statusLabel->setText("Mutex seleccionado - Solo necesitas cargar acciones para iniciar la simulación.");
     } else {
         loadResBtn->setVisible(true);
+        rwPolicyCombo->setVisible(true);
+        priorityCombo->setVisible(false);
+        loadProcBtn->setVisible(false);
         statusLabel->setText("Semáforo seleccionado - Necesitas cargar recursos y acciones para iniciar la simulación.");
     }
 
@@ -440,6 +501,28 @@ void SynchronizationSimulatorWidget::updateInfoDisplay()
     infoDisplay->setPlainText(info);
 }
 
+// Procesos con prioridad (número menor = más prioridad) para las colas del mutex
+void SynchronizationSimulatorWidget::loadProcessesFromDialog()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Cargar Procesos", "", "Text Files (*.txt)");
+    if (fileName.isEmpty()) return;
+
+    QFileInfo fi(fileName);
+    if (fi.fileName() != "processes.txt") {
+        QMessageBox::warning(this, "Archivo incorrecto", "Por favor selecciona un archivo llamado 'processes.txt'.");
+        return;
+    }
+
+    processes = loadProcesses(fileName);
+    processColors.clear();
+    for (const auto& proc : processes) {
+        processColors[proc.pid] = proc.color;
+    }
+    updateInfoDisplay();
+    statusLabel->setText(QString("Cargados %1 procesos desde archivo.").arg(processes.size()));
+    QMessageBox::information(this, "Procesos cargados", QString("Se cargaron %1 procesos.").arg(processes.size()));
+}
+
 void SynchronizationSimulatorWidget::loadResourcesFromDialog()
 {
     QString fileName = QFileDialog::getOpenFileName(this, "Cargar Recursos", "", "Text Files (*.txt)");
@@ -486,6 +569,11 @@ void SynchronizationSimulatorWidget::runSynchronization(const QString &mechanism
         return;
     }
     
+    if (mechanism == "Banker" && resources.empty()) {
+        QMessageBox::warning(this, "Recursos Faltantes", "Por favor carga recursos para la simulación del banquero.");
+        return;
+    }
+    
     if (processes.empty()) {
         std::set<QString> uniquePids;
         for (const auto& action : actions) {
@@ -507,31 +595,46 @@ void SynchronizationSimulatorWidget::runSynchronization(const QString &mechanism
     }
     
     delete syncMechanism;
-    if (mechanism == "Mutex Lock")
+    if (mechanism == "Mutex Lock" && priorityCombo->currentIndex() > 0)
+        syncMechanism = new MutexLock(resources, processes, actions,
+                                      static_cast<PriorityProtocol>(priorityCombo->currentIndex() - 1));
+    else if (mechanism == "Mutex Lock")
         syncMechanism = new MutexLock(resources);
     else if (mechanism == "Semaphore")
-        syncMechanism = new Semaphore(resources);
+        syncMechanism = new Semaphore(resources, static_cast<RWPolicy>(rwPolicyCombo->currentIndex()));
+    else if (mechanism == "Banker")
+        // Reclamos máximos deducidos de la traza cargada
+        syncMechanism = new Banker(resources, Banker::claimsFromActions(actions, resources));
+    else if (mechanism == "Lock Cost")
+        syncMechanism = new CostModelLock(resources, static_cast<LockKind>(lockKindCombo->currentIndex()));
+    else if (mechanism == "RCU")
+        syncMechanism = new RCULock(resources);
+    else if (mechanism == "Seqlock")
+        syncMechanism = new SeqLock(resources);
 
-    currentEvents = SynchronizationSimulator::simulateSynchronization(processes, resources, actions, syncMechanism);
+    currentLog = SynchronizationSimulator::simulateSynchronizationLog(processes, resources, actions, syncMechanism);
+    logGeneration++;
+    // Directamente de los tramos: nada se expande a un evento por ciclo
+    currentIndex = ProcessStateIndex(processes, currentLog);
+    maxCycles = currentIndex.lastCycle();
     
-    maxCycles = 0;
-    int minCycles = INT_MAX;
-    for (const auto& event : currentEvents) {
-        maxCycles = std::max(maxCycles, event.cycle);
-        minCycles = std::min(minCycles, event.cycle);
-    }
-    
-    syncTable->setRowCount(currentEvents.size());
-    for (int i = 0; i < currentEvents.size(); ++i) {
-        const auto &event = currentEvents[i];
-        syncTable->setItem(i, 0, new QTableWidgetItem(event.pid));
-        syncTable->setItem(i, 1, new QTableWidgetItem(event.state == ProcessState::ACCESSED ? "ACCESSED" : "WAITING"));
-        syncTable->setItem(i, 2, new QTableWidgetItem(event.resource));
-        syncTable->setItem(i, 3, new QTableWidgetItem(event.action_type));
-        syncTable->setItem(i, 4, new QTableWidgetItem(QString::number(event.cycle)));
+    // Una fila por tramo: una espera larga ocupa una sola fila
+    const auto& intervals = currentLog.intervals;
+    syncTable->clearContents();
+    syncTable->setRowCount(intervals.size());
+    for (int i = 0; i < intervals.size(); ++i) {
+        const auto &interval = intervals[i];
+        QString cycles = interval.start_cycle == interval.end_cycle
+            ? QString::number(interval.start_cycle)
+            : QString("%1-%2").arg(interval.start_cycle).arg(interval.end_cycle);
+        syncTable->setItem(i, 0, new QTableWidgetItem(currentLog.processes.name(interval.pid)));
+        syncTable->setItem(i, 1, new QTableWidgetItem(interval.state == ProcessState::ACCESSED ? "ACCESSED" : "WAITING"));
+        syncTable->setItem(i, 2, new QTableWidgetItem(currentLog.resources.name(interval.resource)));
+        syncTable->setItem(i, 3, new QTableWidgetItem(currentLog.action_types.name(interval.type)));
+        syncTable->setItem(i, 4, new QTableWidgetItem(cycles));
         
-        QColor rowColor = (event.state == ProcessState::ACCESSED) ? QColor("#d4edda") : QColor("#f8d7da");
-        for (int j = 0; j < 5; ++j) {
+        QColor rowColor = (interval.state == ProcessState::ACCESSED) ? QColor("#d4edda") : QColor("#f8d7da");
+        for (int j = 0; j < syncTable->columnCount(); ++j) {
             if (syncTable->item(i, j)) {
                 syncTable->item(i, j)->setBackground(rowColor);
             }
@@ -543,13 +646,162 @@ void SynchronizationSimulatorWidget::runSynchronization(const QString &mechanism
     currentAnimationCycle = 0;
     animationTimer->start(1500);
     
-    statusLabel->setText(QString(" Simulación iniciada. %1 eventos en ciclos 0-%2.")
-                        .arg(currentEvents.size()).arg(maxCycles));
+    QString status = QString(" Simulación iniciada. %1 eventos en ciclos 0-%2.")
+                        .arg(currentIndex.eventCount()).arg(maxCycles);
+    if (!currentLog.deadlocks.empty()) {
+        const SyncDeadlock& first = currentLog.deadlocks.front();
+        QStringList pids;
+        for (int pid : first.pids) {
+            pids << currentLog.processes.name(pid);
+        }
+        status += QString(" %1 interbloqueo(s); el primero en el ciclo %2: %3.")
+                      .arg(currentLog.deadlocks.size()).arg(first.cycle).arg(pids.join(", "));
+    }
+    statusLabel->setText(status);
+
+    if (mechanism == "Semaphore") {
+        RWReport report = currentLog.rwReport();
+        updateInfoDisplay();
+        infoDisplay->append(QString("Política: %1\nEspera de escritores (ciclos): p50=%2 p95=%3 p99=%4 máx=%5\n"
+                                    "Escritores sin atender: %6\nAccesos por ciclo: %7")
+                                .arg(rwPolicyCombo->currentText())
+                                .arg(report.writer_wait_p50).arg(report.writer_wait_p95)
+                                .arg(report.writer_wait_p99).arg(report.writer_wait_max)
+                                .arg(report.starved_writers)
+                                .arg(report.throughput, 0, 'f', 2));
+    }
+
+    if (mechanism == "Lock Cost") {
+        LockCostReport report = static_cast<CostModelLock*>(syncMechanism)->costReport();
+        updateInfoDisplay();
+        infoDisplay->append(QString("Cerrojo: %1\nAdquisiciones: %2 (%3 con espera), CPU perdida: %4 ciclos\n"
+                                    "Traspaso (ciclos): p50=%5 p99=%6 máx=%7, líneas movidas: %8, cambios de contexto: %9")
+                                .arg(lockKindCombo->currentText())
+                                .arg(report.acquisitions).arg(report.contended).arg(report.wasted_cycles)
+                                .arg(report.handoff_p50).arg(report.handoff_p99).arg(report.handoff_max)
+                                .arg(report.line_transfers).arg(report.context_switches));
+    }
+
+    if (mechanism == "RCU" || mechanism == "Seqlock") {
+        ReadMostlyReport report = mechanism == "RCU"
+            ? static_cast<RCULock*>(syncMechanism)->report(currentLog)
+            : static_cast<SeqLock*>(syncMechanism)->report(currentLog);
+        updateInfoDisplay();
+        infoDisplay->append(QString("Lecturas: %1 (%2 por ciclo), espera máx. de lectores: %3\n"
+                                    "Escrituras: %4, espera p99: %5; coste tras la sección p99=%6 máx=%7\n"
+                                    "Lecturas repetidas: %8 (%9 ciclos)")
+                                .arg(report.reads).arg(report.read_throughput, 0, 'f', 2)
+                                .arg(report.reader_wait_max).arg(report.writes).arg(report.writer_wait_p99)
+                                .arg(report.writer_cost_p99).arg(report.writer_cost_max)
+                                .arg(report.read_retries).arg(report.retry_cycles));
+    }
+
+    if (mechanism == "Mutex Lock" && priorityCombo->currentIndex() > 0) {
+        std::vector<PriorityBlocking> report = currentLog.priorityBlocking();
+        int top = 0, worst = 0, worstInversion = 0, blocked = 0, inversion = 0;
+        for (const auto& entry : report) {
+            // Peor caso de los procesos más prioritarios
+            if (entry.priority == report.front().priority) {
+                top++;
+                worst = std::max(worst, entry.worst_blocking);
+                worstInversion = std::max(worstInversion, entry.worst_inversion);
+            }
+            blocked += entry.blocked_cycles;
+            inversion += entry.inversion_cycles;
+        }
+        updateInfoDisplay();
+        infoDisplay->append(QString("Protocolo: %1\nMás prioritarios (%2): espera máx=%3, inversión máx=%4\n"
+                                    "Inversión total: %5 de %6 ciclos en espera")
+                                .arg(priorityCombo->currentText())
+                                .arg(top).arg(worst).arg(worstInversion)
+                                .arg(inversion).arg(blocked));
+    }
+}
+
+// Ejecuta la traza con hilos reales y la compara con la última simulación
+void SynchronizationSimulatorWidget::runThreadReplay()
+{
+    if (replayThread) return;
+    if (actions.empty() || currentLog.intervals.empty()) {
+        QMessageBox::warning(this, "Datos Faltantes", "Por favor ejecuta una simulación antes de compararla con hilos reales.");
+        return;
+    }
+
+    const ReplayPrimitive primitive = static_cast<ReplayPrimitive>(replayCombo->currentIndex());
+    if (primitive == ReplayPrimitive::SEMAPHORE && resources.empty()) {
+        QMessageBox::warning(this, "Recursos Faltantes", "Por favor carga recursos para ejecutar con semáforos POSIX.");
+        return;
+    }
+
+    // Los hilos reales tardan lo que dure la traza (más el plazo si se
+    // interbloquea): se ejecutan fuera del hilo de la interfaz con copias de
+    // la carga y de la simulación
+    auto result = std::make_shared<ReplayResult>();
+    auto comparison = std::make_shared<ReplayComparison>();
+    const int generation = logGeneration;
+    const QString primitiveName = replayCombo->currentText();
+    replayThread = QThread::create([result, comparison, primitive,
+                                    actions = actions, resources = resources, log = currentLog]() {
+        *result = ThreadReplay::run(actions, resources, primitive);
+        *comparison = ThreadReplay::compare(*result, log);
+    });
+    connect(replayThread, &QThread::finished, this, [this, result, comparison, generation, primitiveName]() {
+        replayThread->deleteLater();
+        replayThread = nullptr;
+        replayBtn->setEnabled(true);
+        if (!result->error.isEmpty()) {
+            statusLabel->setText(" Ejecución con hilos cancelada.");
+            QMessageBox::warning(this, "Ejecución con hilos", "No se pudo ejecutar con hilos reales: " + result->error);
+        } else if (generation != logGeneration) {
+            statusLabel->setText(" Ejecución con hilos descartada: la simulación cambió mientras corría.");
+        } else {
+            showThreadReplay(*result, *comparison, primitiveName);
+        }
+    });
+    replayBtn->setEnabled(false);
+    statusLabel->setText(" Ejecutando con hilos reales...");
+    replayThread->start();
+}
+
+void SynchronizationSimulatorWidget::showThreadReplay(const ReplayResult& result, const ReplayComparison& comparison,
+                                                      const QString& primitiveName)
+{
+    // Columna "Medido": ciclo real en que obtuvo el recurso, o ciclos de espera real
+    const double cycle_ns = result.cycle_us * 1000.0;
+    for (int i = 0; i < currentLog.intervals.size(); ++i) {
+        const auto& interval = currentLog.intervals[i];
+        if (interval.action < 0 || interval.action >= static_cast<int>(result.samples.size())) continue;
+        const ReplaySample& sample = result.samples[interval.action];
+        QString measured;
+        if (interval.state == ProcessState::ACCESSED) {
+            measured = sample.timed_out ? "—" : QString::number(sample.acquired_cycle);
+        } else {
+            measured = QString::number(sample.wait_ns / cycle_ns, 'f', 1);
+        }
+        QTableWidgetItem* item = new QTableWidgetItem(measured);
+        if (syncTable->item(i, 0)) {
+            item->setBackground(syncTable->item(i, 0)->background());
+        }
+        syncTable->setItem(i, 5, item);
+    }
+
+    updateInfoDisplay();
+    infoDisplay->append(QString("Hilos (%1): %2 adquisiciones, %3 con espera, %4 sin obtener\n"
+                                "Espera real (µs): p50=%5 p99=%6 máx=%7\n"
+                                "Frente a la simulación: error medio %8 ciclos (máx. %9), esperas %10 simuladas / %11 reales")
+                            .arg(primitiveName)
+                            .arg(result.total.acquisitions).arg(result.total.contended).arg(result.total.timed_out)
+                            .arg(result.total.wait_p50_ns / 1000).arg(result.total.wait_p99_ns / 1000)
+                            .arg(result.total.wait_max_ns / 1000)
+                            .arg(comparison.mean_abs_error, 0, 'f', 2).arg(comparison.max_abs_error)
+                            .arg(comparison.simulated_waits).arg(comparison.measured_waits));
+    statusLabel->setText(QString(" Ejecución con hilos terminada: %1 de %2 acciones coinciden con la simulación.")
+                             .arg(comparison.matched).arg(result.samples.size()));
 }
 
 void SynchronizationSimulatorWidget::setupEmptyTimeline()
 {
-    if (currentEvents.empty()) return;
+    if (currentIndex.eventCount() == 0) return;
 
     auto children = simulationArea->findChildren<QWidget*>();
     for (auto child : children) {
@@ -557,15 +809,8 @@ void SynchronizationSimulatorWidget::setupEmptyTimeline()
     }
 
     int minCycle = 0;
-    int maxCycle = 0;
-    for (const auto& event : currentEvents) {
-        maxCycle = std::max(maxCycle, event.cycle);
-    }
-
-    std::set<QString> uniqueProcesses;
-    for (const auto& event : currentEvents) {
-        uniqueProcesses.insert(event.pid);
-    }
+    int maxCycle = currentIndex.lastCycle();
+    const std::vector<QString> processList = currentIndex.activeProcesses();
 
     int leftMargin = 80;
     int rightMargin = 50;
@@ -575,16 +820,9 @@ void SynchronizationSimulatorWidget::setupEmptyTimeline()
     int processHeight = 80;
     int axisHeight = 50;
 
-    int numProcesses = uniqueProcesses.size();
+    int numProcesses = processList.size();
 
-    int numBlocksMax = 0;
-    for (int cycle = 0; cycle <= maxCycle; ++cycle) {
-        int count = 0;
-        for (const auto& event : currentEvents) {
-            if (event.cycle == cycle) count++;
-        }
-        numBlocksMax = std::max(numBlocksMax, count);
-    }
+    int numBlocksMax = static_cast<int>(currentIndex.maxEventsPerCycle());
     int blockHeight = 60;
     int blockSpacing = 18;
     int axisY = topMargin + numBlocksMax * (blockHeight + blockSpacing) + 20;
@@ -638,9 +876,6 @@ void SynchronizationSimulatorWidget::setupEmptyTimeline()
         numberLabel->show();
     }
 
-    std::vector<QString> processList(uniqueProcesses.begin(), uniqueProcesses.end());
-    std::sort(processList.begin(), processList.end());
-
     QLabel* waitingInfo = new QLabel(simulationArea);
     waitingInfo->setObjectName("waitingInfo");
     waitingInfo->setText("<b>Estado:</b> Preparando animación...");
@@ -681,72 +916,65 @@ void SynchronizationSimulatorWidget::nextAnimationStep()
     int blockIndex = 0;
     int blockSpacing = 18;
     int blockHeight = 60;
-    int numBlocksMax = 0;
-    // Calcula el máximo de bloques en un ciclo
-    for (int cycle = 0; cycle <= maxCycle; ++cycle) {
-        int count = 0;
-        for (const auto& event : currentEvents) {
-            if (event.cycle == cycle) count++;
-        }
-        numBlocksMax = std::max(numBlocksMax, count);
-    }
+    // Máximo de bloques en un ciclo
+    int numBlocksMax = static_cast<int>(currentIndex.maxEventsPerCycle());
     int axisY = topMargin + numBlocksMax * (blockHeight + blockSpacing) + 20; // 20px extra de margen
 
-    for (const auto& event : currentEvents) {
-        if (event.cycle == currentAnimationCycle) {
-            int xPos = leftMargin + currentAnimationCycle * cycleWidth + (cycleWidth - blockWidth) / 2;
-            int yPos = topMargin + blockIndex * (blockHeight + blockSpacing); // Empieza debajo de la barra
-
-            QLabel* eventBlock = new QLabel(simulationArea);
-            eventBlock->setObjectName(QString("eventBlock_c%1_idx%2").arg(currentAnimationCycle).arg(blockIndex));
-            QString eventText = QString(
-                "<div style='text-align:center;'>"
-                "<span style='font-size:18px;font-weight:bold;'>%1</span><br>"
-                "<span style='font-size:12px;'>%2</span><br>"
-                "<span style='font-size:11px;'>%3</span>"
-                "</div>"
-            ).arg(event.pid).arg(event.action_type).arg(event.resource);
-            eventBlock->setText(eventText);
-            eventBlock->setAlignment(Qt::AlignCenter);
-            eventBlock->setWordWrap(true);
-
-            QString bgColor, borderColor, textColor;
-            if (event.state == ProcessState::ACCESSED) {
-                bgColor = "#6ee7b7";
-                borderColor = "#10b981";
-                textColor = "#134e4a";
-                accessedCount++;
-                currentCycleInfo.append(QString("%1:✓%2(%3)").arg(event.pid, event.resource, event.action_type));
-            } else {
-                bgColor = "#fdba74";
-                borderColor = "#ea580c";
-                textColor = "#7c2d12";
-                waitingCount++;
-                currentCycleInfo.append(QString("%1:⏳%2(%3)").arg(event.pid, event.resource, event.action_type));
-            }
+    // Solo los eventos de este ciclo
+    const std::vector<SyncEvent> cycleEvents = currentIndex.eventsInWindow(currentAnimationCycle, currentAnimationCycle);
+    for (const SyncEvent& event : cycleEvents) {
+        int xPos = leftMargin + currentAnimationCycle * cycleWidth + (cycleWidth - blockWidth) / 2;
+        int yPos = topMargin + blockIndex * (blockHeight + blockSpacing); // Empieza debajo de la barra
+
+        QLabel* eventBlock = new QLabel(simulationArea);
+        eventBlock->setObjectName(QString("eventBlock_c%1_idx%2").arg(currentAnimationCycle).arg(blockIndex));
+        QString eventText = QString(
+            "<div style='text-align:center;'>"
+            "<span style='font-size:18px;font-weight:bold;'>%1</span><br>"
+            "<span style='font-size:12px;'>%2</span><br>"
+            "<span style='font-size:11px;'>%3</span>"
+            "</div>"
+        ).arg(event.pid).arg(event.action_type).arg(event.resource);
+        eventBlock->setText(eventText);
+        eventBlock->setAlignment(Qt::AlignCenter);
+        eventBlock->setWordWrap(true);
 
-            eventBlock->setStyleSheet(QString(
-                "background: %1;"
-                "border: 2px solid %2;"
-                "border-radius: 12px;"
-                "font-size: 13px;"
-                "color: %3;"
-                "padding: 4px 2px 4px 2px;"
-                "min-width: %4px; min-height: %5px;"
-                "max-width: %4px; max-height: %5px;"
-            ).arg(bgColor, borderColor, textColor).arg(blockWidth).arg(blockHeight));
-
-            QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(eventBlock);
-            shadow->setBlurRadius(8);
-            shadow->setColor(QColor(0,0,0,35));
-            shadow->setOffset(0, 3);
-            eventBlock->setGraphicsEffect(shadow);
-
-            eventBlock->setGeometry(xPos, yPos, blockWidth, blockHeight);
-            eventBlock->show();
-
-            blockIndex++;
+        QString bgColor, borderColor, textColor;
+        if (event.state == ProcessState::ACCESSED) {
+            bgColor = "#6ee7b7";
+            borderColor = "#10b981";
+            textColor = "#134e4a";
+            accessedCount++;
+            currentCycleInfo.append(QString("%1:✓%2(%3)").arg(event.pid, event.resource, event.action_type));
+        } else {
+            bgColor = "#fdba74";
+            borderColor = "#ea580c";
+            textColor = "#7c2d12";
+            waitingCount++;
+            currentCycleInfo.append(QString("%1:⏳%2(%3)").arg(event.pid, event.resource, event.action_type));
         }
+
+        eventBlock->setStyleSheet(QString(
+            "background: %1;"
+            "border: 2px solid %2;"
+            "border-radius: 12px;"
+            "font-size: 13px;"
+            "color: %3;"
+            "padding: 4px 2px 4px 2px;"
+            "min-width: %4px; min-height: %5px;"
+            "max-width: %4px; max-height: %5px;"
+        ).arg(bgColor, borderColor, textColor).arg(blockWidth).arg(blockHeight));
+
+        QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(eventBlock);
+        shadow->setBlurRadius(8);
+        shadow->setColor(QColor(0,0,0,35));
+        shadow->setOffset(0, 3);
+        eventBlock->setGraphicsEffect(shadow);
+
+        eventBlock->setGeometry(xPos, yPos, blockWidth, blockHeight);
+        eventBlock->show();
+
+        blockIndex++;
     }
     
     QLabel* waitingInfo = simulationArea->findChild<QLabel*>("waitingInfo");
@@ -776,14 +1004,9 @@ void SynchronizationSimulatorWidget::nextAnimationStep()
         statusLabel->setText("Animación completada. Todos los eventos han sido procesados.");
         
         if (waitingInfo) {
-            int totalEvents = currentEvents.size();
-            int totalAccessed = 0;
-            int totalWaiting = 0;
-            
-            for (const auto& event : currentEvents) {
-                if (event.state == ProcessState::ACCESSED) totalAccessed++;
-                else totalWaiting++;
-            }
+            long long totalEvents = currentIndex.eventCount();
+            long long totalAccessed = currentIndex.eventCount(ProcessState::ACCESSED);
+            long long totalWaiting = totalEvents - totalAccessed;
             
             waitingInfo->setGeometry(80, simulationArea->property("axisY").toInt() + 40, simulationArea->width() - 160, 40);
             waitingInfo->setText(QString(
@@ -800,7 +1023,9 @@ void SynchronizationSimulatorWidget::clearAll()
     processes.clear();
     resources.clear();
     actions.clear();
-    currentEvents.clear();
+    currentLog = SyncLog();
+    logGeneration++;
+    currentIndex = ProcessStateIndex();
     processColors.clear();
     
     syncTable->setRowCount(0);
@@ -868,6 +1093,6 @@ void SynchronizationSimulatorWidget::showInfo()
         .arg(currentSyncType)
         .arg(resources.size())
         .arg(actions.size())
-        .arg(currentEvents.size())
+        .arg(currentIndex.eventCount())
         .arg(maxCycles));
 }
\ No newline at end of file
@@ -13,8 +13,10 @@
 #include <map>
 #include <set>
 #include "synchronizer.h" 
+#include "threadreplay.h"
 
 class SynchronizationMechanism;
+class QThread;
 
 class SynchronizationSimulatorWidget : public QWidget {
     Q_OBJECT
@@ -35,6 +37,9 @@ private:
     void loadResourcesFromDialog();
     void loadActionsFromDialog();
     void runSynchronization(const QString &mechanism);
+    void runThreadReplay();
+    void showThreadReplay(const ReplayResult& result, const ReplayComparison& comparison,
+                          const QString& primitiveName);
     void showSimulationEvents(const std::vector<SyncEvent>& events);
     void setupEmptyTimeline();
     void clearAll();
@@ -46,6 +51,10 @@ private:
     QStackedWidget* mainStack_;
     QWidget* menuWidget_;
     QComboBox* syncTypeCombo;
+    QComboBox* rwPolicyCombo;
+    QComboBox* priorityCombo;
+    QComboBox* lockKindCombo;
+    QComboBox* replayCombo;
     QLabel* statusLabel;
     QLabel* cycleLabel;
     QTextEdit* infoDisplay;
@@ -59,7 +68,9 @@ private:
     QTimer* animationTimer;
     int currentAnimationCycle;
     int maxCycles;
-    std::vector<SyncEvent> currentEvents;
+    SyncLog currentLog;
+    int logGeneration = 0; // cambia con cada simulación o limpieza
+    ProcessStateIndex currentIndex;
     
     // Data
     std::vector<Resource> resources;
@@ -73,6 +84,11 @@ private:
     QStringList colorPalette = {"#FF6B6B", "#4ECDC4", "#45B7D1", "#96CEB4", "#FFEAA7", "#DDA0DD", "#98D8C8", "#F7DC6F"};
 
     // Buttons
+    QPushButton *loadProcBtn;
     QPushButton *loadResBtn;
     QPushButton *loadActBtn;
+    QPushButton *replayBtn;
+
+    // Ejecución con hilos reales en curso (nullptr si no hay)
+    QThread* replayThread = nullptr;
 };
\ No newline at end of file
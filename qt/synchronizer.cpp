@@ -1,76 +1,287 @@
 #include "synchronizer.h"
+#include "timingwheel.h"
+#include <QDebug>
 #include <algorithm>
 #include <map>
 #include <set>
 #include <queue>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include <thread>
+#include <climits>
+
+AccessType parseAccessType(const QString& action_type) {
+    if (action_type == "READ") return AccessType::READ;
+    if (action_type == "WRITE") return AccessType::WRITE;
+    return AccessType::OTHER;
+}
+
+// Percentil por rango más cercano sobre valores ya ordenados (no vacíos)
+static int nearestRank(const std::vector<int>& sorted, int p) {
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+int NameTable::intern(const QString& name) {
+    int id = ids.value(name, -1);
+    if (id < 0) {
+        id = static_cast<int>(names.size());
+        ids.insert(name, id);
+        names.push_back(name);
+    }
+    return id;
+}
+
+int NameTable::find(const QString& name) const {
+    return ids.value(name, -1);
+}
+
+void NameTable::clear() {
+    ids.clear();
+    names.clear();
+}
+
+bool SynchronizationMechanism::tryAcquire(const QString& resource, const QString& pid, const QString& action_type) {
+    return tryAcquire(resourceId(resource), processId(pid), parseAccessType(action_type));
+}
+
+void SynchronizationMechanism::release(const QString& resource, const QString& pid) {
+    release(resourceId(resource), processId(pid));
+}
+
+bool SynchronizationMechanism::isAvailable(const QString& resource) const {
+    return isAvailable(lookupResource(resource));
+}
+
+int SynchronizationMechanism::lookupResource(const QString& resource) const {
+    int id = resource_names.find(resource);
+    return id >= 0 ? id : resource_names.size();
+}
 
 MutexLock::MutexLock(const std::vector<Resource>& res) : resources(res) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
+    resetResources();
+}
+
+MutexLock::MutexLock(const std::vector<Resource>& res, const std::vector<Process>& processes,
+                     const std::vector<Action>& actions, PriorityProtocol priority_protocol)
+    : resources(res), prioritized(true), protocol(priority_protocol) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
+    QHash<QString, int> priority_of;
+    for (const auto& process : processes) {
+        priority_of.insert(process.pid, process.priority);
+    }
+    // Techo de un recurso: la prioridad más alta entre quienes lo piden
+    for (const auto& action : actions) {
+        int pid = processId(action.pid);
+        int resource = resourceId(action.resource);
+        ensureProcess(pid);
+        ensureResource(resource);
+        base_priority[pid] = priority_of.value(action.pid, INT_MAX);
+        ceilings[resource] = std::min(ceilings[resource], base_priority[pid]);
+    }
     resetResources();
 }
 
-bool MutexLock::tryAcquire(const QString& resource, const QString& pid, const QString& action_type) {
+void MutexLock::ensureResource(int resource) {
+    if (resource >= static_cast<int>(owners.size())) {
+        owners.resize(resource + 1, -1);
+    }
+    if (prioritized && resource >= static_cast<int>(ceilings.size())) {
+        ceilings.resize(resource + 1, INT_MAX);
+        waiters.resize(resource + 1);
+    }
+}
+
+void MutexLock::ensureProcess(int pid) {
+    if (pid >= static_cast<int>(base_priority.size())) {
+        base_priority.resize(pid + 1, INT_MAX); // sin prioridad conocida: la más baja
+        held.resize(pid + 1);
+    }
+}
+
+int MutexLock::basePriority(int pid) const {
+    return pid < static_cast<int>(base_priority.size()) ? base_priority[pid] : INT_MAX;
+}
+
+int MutexLock::ceilingOf(int resource) const {
+    return resource < static_cast<int>(ceilings.size()) ? ceilings[resource] : INT_MAX;
+}
+
+int MutexLock::waitRank(int pid) const {
+    if (!prioritized) return 0;
+    int rank = basePriority(pid);
+    if (pid >= static_cast<int>(held.size())) return rank;
+
+    if (protocol == PriorityProtocol::CEILING) {
+        // Techo inmediato: al entrar sube al techo de lo que retiene
+        for (int resource : held[pid]) {
+            rank = std::min(rank, ceilingOf(resource));
+        }
+    } else if (protocol == PriorityProtocol::INHERITANCE) {
+        // Hereda de quienes esperan lo que retiene, y de quienes esperan a estos
+        if (seen.size() < static_cast<size_t>(process_names.size())) {
+            seen.resize(process_names.size(), 0);
+        }
+        epoch++;
+        stack.assign(1, pid);
+        seen[pid] = epoch;
+        while (!stack.empty()) {
+            int current = stack.back();
+            stack.pop_back();
+            rank = std::min(rank, basePriority(current));
+            if (current >= static_cast<int>(held.size())) continue;
+            for (int resource : held[current]) {
+                for (int waiter : waiters[resource]) {
+                    if (seen[waiter] != epoch) {
+                        seen[waiter] = epoch;
+                        stack.push_back(waiter);
+                    }
+                }
+            }
+        }
+    }
+    return rank;
+}
+
+bool MutexLock::tryAcquire(int resource, int pid, AccessType) {
+    ensureResource(resource);
     // Solo un proceso por recurso, sin importar READ/WRITE
-    if (resource_owners.find(resource) == resource_owners.end()) {
+    if (owners[resource] < 0) {
         // Recurso libre, se asigna
-        resource_owners[resource] = pid;
+        owners[resource] = pid;
+        if (prioritized) {
+            ensureProcess(pid);
+            held[pid].push_back(resource);
+        }
         return true;
     }
     // Recurso ocupado, debe esperar
     return false;
 }
 
-void MutexLock::release(const QString& resource, const QString& pid) {
+void MutexLock::release(int resource, int pid) {
     // Liberar si es el dueño actual
-    if (resource_owners.find(resource) != resource_owners.end() && 
-        resource_owners[resource] == pid) {
-        resource_owners.erase(resource);
+    if (resource < static_cast<int>(owners.size()) && owners[resource] == pid) {
+        owners[resource] = -1;
+        if (prioritized) {
+            auto& list = held[pid];
+            list.erase(std::find(list.begin(), list.end(), resource));
+        }
+    }
+}
+
+void MutexLock::onWait(int resource, int pid, AccessType) {
+    if (prioritized && protocol == PriorityProtocol::INHERITANCE) {
+        ensureResource(resource);
+        waiters[resource].push_back(pid);
+    }
+}
+
+bool MutexLock::onWaitEnd(int resource, int pid, AccessType) {
+    if (prioritized && protocol == PriorityProtocol::INHERITANCE) {
+        auto& list = waiters[resource];
+        auto it = std::find(list.begin(), list.end(), pid);
+        if (it != list.end()) {
+            list.erase(it);
+        }
     }
+    return false;
 }
 
-bool MutexLock::isAvailable(const QString& resource) const {
-    return resource_owners.find(resource) == resource_owners.end();
+bool MutexLock::isAvailable(int resource) const {
+    return resource >= static_cast<int>(owners.size()) || owners[resource] < 0;
 }
 
 bool MutexLock::hasWriter(const QString& resource) const {
-    return resource_owners.find(resource) != resource_owners.end();
+    return !isAvailable(lookupResource(resource));
 }
 
 bool MutexLock::hasReaders(const QString& resource) const {
     return false; 
 }
 
+std::unique_ptr<SynchronizationMechanism> MutexLock::clone() const {
+    return std::make_unique<MutexLock>(*this);
+}
+
 void MutexLock::resetResources() {
-    resource_owners.clear();
+    owners.assign(resource_names.size(), -1);
+    if (prioritized) {
+        ceilings.resize(resource_names.size(), INT_MAX);
+        waiters.assign(resource_names.size(), {});
+        held.assign(process_names.size(), {});
+        base_priority.resize(process_names.size(), INT_MAX);
+    }
 }
 
-Semaphore::Semaphore(const std::vector<Resource>& res) : resources(res) {
+Semaphore::Semaphore(const std::vector<Resource>& res, RWPolicy rw_policy) : resources(res), policy(rw_policy) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
     resetResources();
 }
 
-bool Semaphore::tryAcquire(const QString& resource, const QString& pid, const QString& action_type) {
-    if (action_type == "WRITE") {
+void Semaphore::ensureResource(int resource) {
+    if (resource >= static_cast<int>(available_counts.size())) {
+        // Recurso no declarado: sin cupos, como el contador por defecto
+        available_counts.resize(resource + 1, 0);
+        max_counts.resize(resource + 1, 0);
+        writers.resize(resource + 1, -1);
+        reader_counts.resize(resource + 1, 0);
+        waiting_writers.resize(resource + 1, 0);
+        waiting_readers.resize(resource + 1, 0);
+        read_phase.resize(resource + 1, 0);
+        phase_epoch.resize(resource + 1, 0);
+    }
+}
+
+void Semaphore::ensureProcess(int pid) {
+    if (pid >= static_cast<int>(reading.size())) {
+        reading.resize(pid + 1);
+        read_waits.resize(pid + 1);
+    }
+}
+
+bool Semaphore::tryAcquire(int resource, int pid, AccessType type) {
+    ensureResource(resource);
+    if (type == AccessType::WRITE) {
         // No puede acceder si hay otro escritor o lectores activos
-        if (current_writers.find(resource) != current_writers.end() || 
-            !current_readers[resource].empty()) {
+        if (writers[resource] >= 0 || reader_counts[resource] > 0) {
             return false; 
         }
-        current_writers[resource] = pid;
-        resource_holders[resource].push_back(pid);
-        resource_counts[resource] = 0; // Bloquea todos los cupos
+        // Fase justa: primero los lectores que esperaban al escritor anterior
+        if (policy == RWPolicy::PHASE_FAIR && read_phase[resource] > 0) {
+            return false;
+        }
+        writers[resource] = pid;
+        available_counts[resource] = 0; // Bloquea todos los cupos
         return true;
     }
-    else if (action_type == "READ") {
+    else if (type == AccessType::READ) {
         // Puede compartir con otros lectores
         //  No puede acceder si hay un escritor activo
-        if (current_writers.find(resource) != current_writers.end()) {
+        if (writers[resource] >= 0) {
             return false; // Hay escritor, debe esperar
         }
+        // Con escritores esperando, los lectores nuevos no se adelantan
+        if (waiting_writers[resource] > 0 &&
+            (policy == RWPolicy::WRITER_PREFERENCE ||
+             (policy == RWPolicy::PHASE_FAIR && read_phase[resource] == 0))) {
+            return false;
+        }
         
         // Puede leer si hay cupos disponibles
-        if (resource_counts[resource] > 0) {
-            resource_counts[resource]--;
-            current_readers[resource].push_back(pid);
-            resource_holders[resource].push_back(pid);
+        if (available_counts[resource] > 0) {
+            ensureProcess(pid);
+            available_counts[resource]--;
+            reader_counts[resource]++;
+            reading[pid].push_back(resource);
             return true;
         }
         return false; // No hay cupos para lectores
@@ -79,191 +290,1907 @@ bool Semaphore::tryAcquire(const QString& resource, const QString& pid, const QS
     return false;
 }
 
-void Semaphore::release(const QString& resource, const QString& pid) {
-    auto& holders = resource_holders[resource];
-    auto it = std::find(holders.begin(), holders.end(), pid);
-    if (it != holders.end()) {
-        holders.erase(it);
+void Semaphore::release(int resource, int pid) {
+    if (resource >= static_cast<int>(available_counts.size())) {
+        return;
     }
     
     // Si era escritor
-    if (current_writers.find(resource) != current_writers.end() && 
-        current_writers[resource] == pid) {
-        current_writers.erase(resource); // Quitar escritor
-        resource_counts[resource] = max_counts[resource]; // Restaurar todos los cupos
+    if (writers[resource] == pid) {
+        writers[resource] = -1; // Quitar escritor
+        available_counts[resource] = max_counts[resource]; // Restaurar todos los cupos
+        // Fase de lectura: pasan los lectores que esperaban a este escritor.
+        // Solo ellos la consumen (en onWaitEnd), no los que llegan después
+        if (policy == RWPolicy::PHASE_FAIR) {
+            read_phase[resource] = waiting_readers[resource];
+            phase_epoch[resource]++;
+        }
         return;
     }
     
     // Si era lector 
-    auto& readers = current_readers[resource];
-    auto reader_it = std::find(readers.begin(), readers.end(), pid);
-    if (reader_it != readers.end()) {
-        readers.erase(reader_it); // Quitar lector
-        resource_counts[resource]++; // Liberar un cupo
+    if (pid < static_cast<int>(reading.size())) {
+        auto& held = reading[pid];
+        auto reader_it = std::find(held.begin(), held.end(), resource);
+        if (reader_it != held.end()) {
+            held.erase(reader_it); // Quitar lector
+            reader_counts[resource]--;
+            available_counts[resource]++; // Liberar un cupo
+        }
     }
 }
 
-bool Semaphore::isAvailable(const QString& resource) const {
+bool Semaphore::isAvailable(int resource) const {
     // Disponible si no hay escritor Y hay cupos para lectores
-    return (current_writers.find(resource) == current_writers.end()) && 
-            (resource_counts.at(resource) > 0);
+    return resource < static_cast<int>(available_counts.size()) &&
+           writers[resource] < 0 && available_counts[resource] > 0;
+}
+
+void Semaphore::onWait(int resource, int pid, AccessType type) {
+    ensureResource(resource);
+    if (type == AccessType::WRITE) {
+        waiting_writers[resource]++;
+    } else if (type == AccessType::READ) {
+        waiting_readers[resource]++;
+        if (policy == RWPolicy::PHASE_FAIR) {
+            ensureProcess(pid);
+            read_waits[pid].push_back({resource, phase_epoch[resource]});
+        }
+    }
+}
+
+bool Semaphore::onWaitEnd(int resource, int pid, AccessType type) {
+    if (type == AccessType::WRITE) {
+        waiting_writers[resource]--;
+        // El último escritor en cola que se va sin entrar deja pasar a los lectores
+        return waiting_writers[resource] == 0 && writers[resource] < 0 &&
+               (policy == RWPolicy::WRITER_PREFERENCE ||
+                (policy == RWPolicy::PHASE_FAIR && read_phase[resource] == 0));
+    }
+    if (type != AccessType::READ) {
+        return false;
+    }
+    waiting_readers[resource]--;
+    if (policy != RWPolicy::PHASE_FAIR) {
+        return false;
+    }
+    // Si esperaba desde antes de liberarse el último escritor, era de la fase
+    auto& waits = read_waits[pid];
+    auto it = std::find_if(waits.begin(), waits.end(),
+                           [resource](const std::pair<int, int>& wait) { return wait.first == resource; });
+    const bool in_phase = it->second < phase_epoch[resource];
+    waits.erase(it);
+    if (!in_phase || read_phase[resource] == 0) {
+        return false;
+    }
+    // Acabada la fase, un escritor en cola puede entrar si no quedan lectores
+    return --read_phase[resource] == 0 && waiting_writers[resource] > 0 &&
+           writers[resource] < 0 && reader_counts[resource] == 0;
+}
+
+std::unique_ptr<SynchronizationMechanism> Semaphore::clone() const {
+    return std::make_unique<Semaphore>(*this);
 }
 
 void Semaphore::resetResources() {
-    resource_counts.clear();
-    resource_holders.clear();
-    max_counts.clear();          
-    current_writers.clear();     
-    current_readers.clear();     
+    int count = resource_names.size();
+    available_counts.assign(count, 0);
+    max_counts.assign(count, 0);
+    writers.assign(count, -1);
+    reader_counts.assign(count, 0);
+    reading.clear();
+    waiting_writers.assign(count, 0);
+    waiting_readers.assign(count, 0);
+    read_phase.assign(count, 0);
+    phase_epoch.assign(count, 0);
+    read_waits.clear();
     
     for (const auto& resource : resources) {
-        resource_counts[resource.name] = resource.count;
-        max_counts[resource.name] = resource.count; 
-        resource_holders[resource.name] = std::vector<QString>();
-        current_readers[resource.name] = std::vector<QString>(); 
+        int id = resource_names.find(resource.name);
+        available_counts[id] = resource.count;
+        max_counts[id] = resource.count; 
     }
 }
 
 int Semaphore::getAvailableCount(const QString& resource) const {
-    auto it = resource_counts.find(resource);
-    return (it != resource_counts.end()) ? it->second : 0;
+    int id = lookupResource(resource);
+    return id < static_cast<int>(available_counts.size()) ? available_counts[id] : 0;
 }
 
 bool Semaphore::hasActiveWriter(const QString& resource) const {
-    return current_writers.find(resource) != current_writers.end();
+    int id = lookupResource(resource);
+    return id < static_cast<int>(writers.size()) && writers[id] >= 0;
 }
 
 int Semaphore::getActiveReaders(const QString& resource) const {
-    auto it = current_readers.find(resource);
-    return (it != current_readers.end()) ? it->second.size() : 0;
+    int id = lookupResource(resource);
+    return id < static_cast<int>(reader_counts.size()) ? reader_counts[id] : 0;
 }
 
-// ================================
-// SIMULADOR
-// ================================
+ReaderFreeLock::ReaderFreeLock(const std::vector<Resource>& res) : resources(res) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
+    resetResources();
+}
 
-std::vector<SyncEvent> SynchronizationSimulator::simulateSynchronization(
-    const std::vector<Process>& processes,
-    const std::vector<Resource>& resources,
-    const std::vector<Action>& actions,
-    SynchronizationMechanism* mechanism) {
-    
-    std::vector<SyncEvent> events;
-    std::map<QString, QColor> process_colors;
-    
-    for (const auto& process : processes) {
-        process_colors[process.pid] = process.color;
+void ReaderFreeLock::ensureResource(int resource) {
+    if (resource >= static_cast<int>(writers.size())) {
+        writers.resize(resource + 1, -1);
+        readers.resize(resource + 1);
     }
-    
-    std::vector<Action> sorted_actions = actions;
-    std::sort(sorted_actions.begin(), sorted_actions.end(),
-        [](const Action& a, const Action& b) {
-            return a.cycle < b.cycle;
-        });
-    
-    mechanism->resetResources();
-    
-    std::queue<Action> waiting_queue;
-    std::map<QString, Action> active_processes; 
-    
-    int max_cycle = 0;
-    if (!sorted_actions.empty()) {
-        max_cycle = sorted_actions.back().cycle;
+}
+
+bool ReaderFreeLock::tryAcquire(int resource, int pid, AccessType type) {
+    ensureResource(resource);
+    // Los lectores entran siempre, aunque haya un escritor dentro
+    if (type == AccessType::READ) {
+        readers[resource].push_back(pid);
+        return true;
     }
-    
-    for (int current_cycle = 0; current_cycle <= max_cycle + 5; current_cycle++) {
-        
-        // Liberar procesos que terminaron su ejecución
-        std::vector<QString> to_remove;
-        for (auto& [pid, action] : active_processes) {
-            mechanism->release(action.resource, pid);
-            to_remove.push_back(pid);
+    if (writers[resource] < 0) {
+        writers[resource] = pid;
+        return true;
+    }
+    return false;
+}
+
+void ReaderFreeLock::release(int resource, int pid) {
+    if (resource >= static_cast<int>(writers.size())) return;
+    // Si el proceso lee y escribe a la vez no se sabe cuál vence; se suelta
+    // antes la lectura para no dejar entrar a otro escritor demasiado pronto
+    auto& list = readers[resource];
+    auto it = std::find(list.begin(), list.end(), pid);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    } else if (writers[resource] == pid) {
+        writers[resource] = -1;
+    }
+}
+
+bool ReaderFreeLock::isAvailable(int resource) const {
+    return resource >= static_cast<int>(writers.size()) || writers[resource] < 0;
+}
+
+void ReaderFreeLock::resetResources() {
+    writers.assign(resource_names.size(), -1);
+    readers.assign(resource_names.size(), {});
+}
+
+RCULock::RCULock(const std::vector<Resource>& res, int grace_cycles)
+    : ReaderFreeLock(res), grace_period(std::max(grace_cycles, 0)) {}
+
+std::unique_ptr<SynchronizationMechanism> RCULock::clone() const {
+    return std::make_unique<RCULock>(*this);
+}
+
+ReadMostlyReport RCULock::report(const SyncLog& log) const {
+    ReadMostlyReport report = log.readMostlyReport();
+    const int read_type = log.action_types.find("READ");
+
+    // Por recurso, lecturas ordenadas por inicio con el máximo acumulado del fin
+    std::vector<std::vector<std::pair<int, int>>> reads(log.resources.size());
+    for (const auto& interval : log.intervals) {
+        if (interval.state == ProcessState::ACCESSED && interval.type == read_type) {
+            reads[interval.resource].push_back({interval.start_cycle, interval.end_cycle});
         }
-        for (const auto& pid : to_remove) {
-            active_processes.erase(pid);
+    }
+    for (auto& list : reads) {
+        std::sort(list.begin(), list.end());
+        for (size_t k = 1; k < list.size(); k++) {
+            list[k].second = std::max(list[k].second, list[k - 1].second);
         }
+    }
 
-        // Agregar nuevas acciones de este ciclo a la cola FIFO
-        for (const auto& action : sorted_actions) {
-            if (action.cycle == current_cycle) {
-                waiting_queue.push(action);
-            }
+    // La copia se publica al final de la sección: hay que esperar a los
+    // lectores que empezaron antes y siguen dentro, más la detección
+    std::vector<int> costs;
+    for (const auto& interval : log.intervals) {
+        if (interval.state != ProcessState::ACCESSED || interval.type == read_type) continue;
+        const auto& list = reads[interval.resource];
+        auto it = std::upper_bound(list.begin(), list.end(), std::make_pair(interval.end_cycle, INT_MAX));
+        int readers_out = interval.end_cycle;
+        if (it != list.begin()) {
+            readers_out = std::max(readers_out, std::prev(it)->second);
         }
+        costs.push_back(readers_out - interval.end_cycle + grace_period);
+    }
+    if (!costs.empty()) {
+        std::sort(costs.begin(), costs.end());
+        report.writer_cost_p50 = nearestRank(costs, 50);
+        report.writer_cost_p99 = nearestRank(costs, 99);
+        report.writer_cost_max = costs.back();
+    }
+    return report;
+}
 
-        // Procesar cola FIFO
-        std::queue<Action> still_waiting;
-        
-        while (!waiting_queue.empty()) {
-            Action current_action = waiting_queue.front();
-            waiting_queue.pop();
-            
-            // Solo intentar si el proceso no está ya activo
-            if (active_processes.count(current_action.pid) == 0) {
-                
-                if (mechanism->tryAcquire(current_action.resource, current_action.pid, current_action.type)) {
-                    // Proceso obtiene recurso
-                    active_processes[current_action.pid] = current_action;
-                    events.push_back(SyncEvent(current_action.pid, current_action.resource, 
-                                            current_action.type, current_cycle, 
-                                            ProcessState::ACCESSED, 
-                                            process_colors[current_action.pid]));
-                } else {
-                    // Recurso ocupado, va a seguir esperando
-                    events.push_back(SyncEvent(current_action.pid, current_action.resource, 
-                                            current_action.type, current_cycle, 
-                                            ProcessState::WAITING, 
-                                            process_colors[current_action.pid]));
-                    still_waiting.push(current_action);
-                }
-            }
+SeqLock::SeqLock(const std::vector<Resource>& res) : ReaderFreeLock(res) {}
+
+std::unique_ptr<SynchronizationMechanism> SeqLock::clone() const {
+    return std::make_unique<SeqLock>(*this);
+}
+
+ReadMostlyReport SeqLock::report(const SyncLog& log) const {
+    ReadMostlyReport report = log.readMostlyReport();
+    const int read_type = log.action_types.find("READ");
+
+    // Escrituras por recurso; son excluyentes, así que inicio y fin van en orden
+    std::vector<std::vector<std::pair<int, int>>> writes(log.resources.size());
+    for (const auto& interval : log.intervals) {
+        if (interval.state == ProcessState::ACCESSED && interval.type != read_type) {
+            writes[interval.resource].push_back({interval.start_cycle, interval.end_cycle});
         }
-        
-        // Mantener orden FIFO
-        waiting_queue = still_waiting;
-        
-        // Terminar si no hay más procesos activos ni esperando
-        if (active_processes.empty() && waiting_queue.empty() && current_cycle > max_cycle) {
-            break;
+    }
+    for (auto& list : writes) {
+        std::sort(list.begin(), list.end());
+    }
+
+    // Una lectura que se cruza con una escritura se repite entera cuando el
+    // escritor sale, hasta que cabe sin cruzarse con ninguna
+    for (const auto& interval : log.intervals) {
+        if (interval.state != ProcessState::ACCESSED || interval.type != read_type) continue;
+        const auto& list = writes[interval.resource];
+        const int length = interval.end_cycle - interval.start_cycle + 1;
+        int start = interval.start_cycle;
+        auto it = std::lower_bound(list.begin(), list.end(), start,
+                                   [](const std::pair<int, int>& write, int cycle) { return write.second < cycle; });
+        while (it != list.end() && it->first <= start + length - 1) {
+            report.read_retries++;
+            start = it->second + 1;
+            ++it;
         }
+        report.retry_cycles += start - interval.start_cycle;
     }
-    
-    return events;
+    return report;
 }
 
-std::vector<SyncProcessState> SynchronizationSimulator::getProcessStates(
-    const std::vector<Process>& processes,
-    const std::vector<SyncEvent>& events,
-    int maxCycles) {
-    
-    std::vector<SyncProcessState> states;
-    std::map<QString, SyncProcessState> current_states;
-    
-    for (const auto& process : processes) {
-        current_states[process.pid] = SyncProcessState(process.pid, process.color);
+Banker::Banker(const std::vector<Resource>& res, const std::vector<Claim>& declared)
+    : resources(res), claims(declared) {
+    std::map<QString, int> units;
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+        units[resource.name] = resource.count;
     }
-    
-    for (int cycle = 0; cycle <= maxCycles; cycle++) {
-        for (auto& [pid, state] : current_states) {
-            state.current_state = ProcessState::WAITING;
-            state.waiting_for_resource = "";
+    for (auto& claim : claims) {
+        processId(claim.pid);
+        resourceId(claim.resource);
+        int total = units.count(claim.resource) ? units[claim.resource] : 0;
+        if (claim.units > total) {
+            qDebug() << "Claim of" << claim.pid << "on" << claim.resource << "exceeds its" << total << "units";
+            claim.units = total;
         }
-        
-        for (const auto& event : events) {
-            if (event.cycle == cycle) {
-                current_states[event.pid].current_state = event.state;
-                if (event.state == ProcessState::WAITING) {
-                    current_states[event.pid].waiting_for_resource = event.resource;
-                    current_states[event.pid].cycles_waiting++;
-                } else {
-                    current_states[event.pid].cycles_waiting = 0;
-                }
+    }
+    resetResources();
+}
+
+std::vector<Claim> Banker::claimsFromActions(const std::vector<Action>& actions,
+                                             const std::vector<Resource>& res) {
+    std::map<QString, int> units;
+    for (const auto& resource : res) {
+        units[resource.name] = resource.count;
+    }
+    std::map<std::pair<QString, QString>, int> counts;
+    for (const auto& action : actions) {
+        if (units.count(action.resource)) {
+            counts[{action.pid, action.resource}]++;
+        }
+    }
+    std::vector<Claim> claims;
+    for (const auto& entry : counts) {
+        claims.push_back(Claim(entry.first.first, entry.first.second,
+                               std::min(entry.second, units[entry.first.second])));
+    }
+    return claims;
+}
+
+void Banker::ensureResource(int resource) {
+    if (resource < stride) return;
+    // Recurso no declarado: sin unidades. Se rehace el layout con más columnas
+    int wider = std::max(resource + 1, stride * 2);
+    auto widen = [&](std::vector<int>& matrix) {
+        std::vector<int> copy(static_cast<size_t>(rows) * wider, 0);
+        for (int p = 0; p < rows; p++) {
+            std::copy(matrix.begin() + static_cast<size_t>(p) * stride,
+                      matrix.begin() + static_cast<size_t>(p + 1) * stride,
+                      copy.begin() + static_cast<size_t>(p) * wider);
+        }
+        matrix.swap(copy);
+    };
+    widen(maximum);
+    widen(allocation);
+    widen(need);
+    stride = wider;
+    totals.resize(stride, 0);
+    available.resize(stride, 0);
+}
+
+void Banker::ensureProcess(int pid) {
+    if (pid < rows) return;
+    // Proceso sin reclamo: cualquier petición lo excede
+    rows = pid + 1;
+    maximum.resize(static_cast<size_t>(rows) * stride, 0);
+    allocation.resize(static_cast<size_t>(rows) * stride, 0);
+    need.resize(static_cast<size_t>(rows) * stride, 0);
+    held.resize(rows, 0);
+    warned.resize(rows, 0);
+}
+
+// Sin saltos dentro del ciclo para que el compilador lo vectorice
+bool Banker::fits(int pid) const {
+    const int columns = stride;
+    const int* row = need.data() + static_cast<size_t>(pid) * columns;
+    const int* limit = work.data();
+    int ok = 1;
+    for (int r = 0; r < columns; r++) {
+        ok &= row[r] <= limit[r];
+    }
+    return ok != 0;
+}
+
+void Banker::reclaim(int pid) {
+    const int columns = stride;
+    const int* row = allocation.data() + static_cast<size_t>(pid) * columns;
+    int* total = work.data();
+    for (int r = 0; r < columns; r++) {
+        total[r] += row[r];
+    }
+}
+
+// Solo cuentan los procesos que retienen algo: los demás terminan al final,
+// cuando work ya es el total declarado (los reclamos no lo superan). Primero se
+// prueba el último orden seguro; si falla, búsqueda completa.
+bool Banker::isSafe(int pid, bool newcomer) {
+    work = available;
+    bool ok = true;
+    for (int q : safe_sequence) {
+        if (!fits(q)) {
+            ok = false;
+            break;
+        }
+        reclaim(q);
+    }
+    if (ok && newcomer) {
+        ok = fits(pid);
+    }
+    if (ok) {
+        if (newcomer) safe_sequence.push_back(pid);
+        return true;
+    }
+
+    work = available;
+    pending = safe_sequence;
+    if (newcomer) pending.push_back(pid);
+    order.clear();
+    bool progress = true;
+    while (!pending.empty() && progress) {
+        progress = false;
+        size_t kept = 0;
+        for (int q : pending) {
+            if (fits(q)) {
+                reclaim(q);
+                order.push_back(q);
+                progress = true;
+            } else {
+                pending[kept++] = q;
             }
         }
-        
-        for (const auto& [pid, state] : current_states) {
-            states.push_back(state);
+        pending.resize(kept);
+    }
+    if (!pending.empty()) {
+        return false;
+    }
+    safe_sequence.swap(order);
+    return true;
+}
+
+bool Banker::tryAcquire(int resource, int pid, AccessType) {
+    ensureResource(resource);
+    ensureProcess(pid);
+    const size_t cell = static_cast<size_t>(pid) * stride + resource;
+    if (need[cell] <= 0) {
+        if (!warned[pid]) {
+            qDebug() << "Process" << process_names.name(pid) << "exceeds its claim on" << resource_names.name(resource);
+            warned[pid] = 1;
         }
+        return false;
     }
-    
-    return states;
-}
\ No newline at end of file
+    if (available[resource] <= 0) {
+        return false;
+    }
+
+    // Asignación tentativa: se mantiene solo si el estado sigue siendo seguro
+    const bool newcomer = held[pid] == 0;
+    available[resource]--;
+    allocation[cell]++;
+    need[cell]--;
+    held[pid]++;
+    if (isSafe(pid, newcomer)) {
+        return true;
+    }
+    available[resource]++;
+    allocation[cell]--;
+    need[cell]++;
+    held[pid]--;
+    return false;
+}
+
+void Banker::release(int resource, int pid) {
+    if (resource >= stride || pid >= rows) return;
+    const size_t cell = static_cast<size_t>(pid) * stride + resource;
+    if (allocation[cell] == 0) return;
+    // Liberar nunca vuelve inseguro el estado ni invalida el orden seguro
+    allocation[cell]--;
+    need[cell]++;
+    available[resource]++;
+    if (--held[pid] == 0) {
+        safe_sequence.erase(std::find(safe_sequence.begin(), safe_sequence.end(), pid));
+    }
+}
+
+bool Banker::isAvailable(int resource) const {
+    return resource < stride && available[resource] > 0;
+}
+
+void Banker::resetResources() {
+    stride = resource_names.size();
+    rows = process_names.size();
+    const size_t cells = static_cast<size_t>(rows) * stride;
+
+    totals.assign(stride, 0);
+    for (const auto& resource : resources) {
+        totals[resource_names.find(resource.name)] = std::max(resource.count, 0);
+    }
+    available = totals;
+
+    maximum.assign(cells, 0);
+    for (const auto& claim : claims) {
+        size_t cell = static_cast<size_t>(process_names.find(claim.pid)) * stride + resource_names.find(claim.resource);
+        maximum[cell] = std::max(maximum[cell], claim.units);
+    }
+    allocation.assign(cells, 0);
+    need = maximum;
+    held.assign(rows, 0);
+    warned.assign(rows, 0);
+    safe_sequence.clear();
+}
+
+int Banker::getAvailableCount(const QString& resource) const {
+    int id = lookupResource(resource);
+    return id < stride ? available[id] : 0;
+}
+
+CostModelLock::CostModelLock(const std::vector<Resource>& res, LockKind lock_kind, LockCosts lock_costs)
+    : kind(lock_kind), costs(lock_costs), resources(res) {
+    for (const auto& resource : resources) {
+        resourceId(resource.name);
+    }
+    resetResources();
+}
+
+void CostModelLock::ensureResource(int resource) {
+    if (resource >= static_cast<int>(owners.size())) {
+        owners.resize(resource + 1, -1);
+        last_owner.resize(resource + 1, -1);
+        waiting.resize(resource + 1, 0);
+    }
+}
+
+bool CostModelLock::tryAcquire(int resource, int pid, AccessType) {
+    ensureResource(resource);
+    if (owners[resource] < 0) {
+        owners[resource] = pid;
+        return true;
+    }
+    return false;
+}
+
+void CostModelLock::release(int resource, int pid) {
+    if (resource < static_cast<int>(owners.size()) && owners[resource] == pid) {
+        owners[resource] = -1;
+    }
+}
+
+bool CostModelLock::isAvailable(int resource) const {
+    return resource >= static_cast<int>(owners.size()) || owners[resource] < 0;
+}
+
+void CostModelLock::onWait(int resource, int, AccessType) {
+    ensureResource(resource);
+    waiting[resource]++;
+}
+
+bool CostModelLock::onWaitEnd(int resource, int, AccessType) {
+    waiting[resource]--;
+    return false;
+}
+
+int CostModelLock::acquireCost(int resource, int pid, int waited) {
+    totals.acquisitions++;
+    const int previous = last_owner[resource];
+    last_owner[resource] = pid;
+
+    // Sin espera: una operación atómica, gratis si la línea ya es suya
+    if (waited == 0) {
+        if (previous == pid) return 0;
+        totals.line_transfers++;
+        return costs.cache_transfer;
+    }
+
+    // Con espera: el que suelta escribe y el siguiente tiene que ver el cambio.
+    // Los que siguen en cola (`others`, como mucho uno por núcleo libre) giran
+    // sobre la misma línea en TICKET y mientras SPIN_PARK no se ha dormido; en
+    // promedio el sucesor la obtiene a mitad de esa ronda.
+    const int others = std::min(waiting[resource], std::max(costs.cores - 1, 0));
+    int handoff = costs.cache_transfer;
+    switch (kind) {
+    case LockKind::TICKET:
+        handoff = costs.cache_transfer * (1 + others / 2);
+        totals.line_transfers += 1 + others;
+        totals.wasted_cycles += waited + handoff;
+        break;
+    case LockKind::MCS:
+        // Encolarse (swap en la cola) y recibir el aviso en el nodo propio
+        totals.line_transfers += 2;
+        totals.wasted_cycles += waited + handoff;
+        break;
+    case LockKind::SPIN_PARK:
+        if (waited <= costs.spin_limit) {
+            handoff = costs.cache_transfer * (1 + others / 2);
+            totals.line_transfers += 1 + others;
+            totals.wasted_cycles += waited + handoff;
+        } else {
+            // Se durmió: hay que despertarlo antes de que vuelva a intentar
+            handoff = costs.context_switch + costs.cache_transfer;
+            totals.line_transfers++;
+            totals.context_switches += 2;
+            totals.wasted_cycles += costs.spin_limit + 2 * costs.context_switch;
+        }
+        break;
+    }
+    totals.contended++;
+    handoffs.push_back(handoff);
+    return handoff;
+}
+
+LockCostReport CostModelLock::costReport() const {
+    LockCostReport report = totals;
+    std::vector<int> sorted = handoffs;
+    std::sort(sorted.begin(), sorted.end());
+    if (!sorted.empty()) {
+        report.handoff_p50 = nearestRank(sorted, 50);
+        report.handoff_p99 = nearestRank(sorted, 99);
+        report.handoff_max = sorted.back();
+    }
+    return report;
+}
+
+void CostModelLock::resetResources() {
+    owners.assign(resource_names.size(), -1);
+    last_owner.assign(resource_names.size(), -1);
+    waiting.assign(resource_names.size(), 0);
+    totals = LockCostReport();
+    handoffs.clear();
+}
+
+// ================================
+// SIMULADOR
+// ================================
+
+namespace {
+
+// Acciones agrupadas por ciclo al estilo CSR, solo sobre los ciclos que tienen
+// llegadas: las de cycles[k] están en actions[offsets[k] .. offsets[k + 1]),
+// en el orden en que venían. Construirlo es O(acciones): radix estable por
+// ciclo, sin depender de lo separados que estén los ciclos.
+struct ActionIndex {
+    std::vector<Action> actions;
+    std::vector<int> cycles;
+    std::vector<size_t> offsets;
+    int max_cycle = 0;
+
+    static ActionIndex build(const std::vector<Action>& input) {
+        ActionIndex index;
+        std::vector<size_t> order;
+        order.reserve(input.size());
+        int top = 0;
+        bool sorted = true;
+        for (size_t i = 0; i < input.size(); i++) {
+            const Action& action = input[i];
+            // Último ciclo en que la acción puede retener su recurso
+            index.max_cycle = std::max(index.max_cycle, action.cycle + std::max(action.duration, 1) - 1);
+            // Los ciclos negativos nunca se simulan
+            if (action.cycle >= 0) {
+                sorted = sorted && (order.empty() || input[order.back()].cycle <= action.cycle);
+                top = std::max(top, action.cycle);
+                order.push_back(i);
+            }
+        }
+        if (!sorted) {
+            sortByCycle(input, order, top);
+        }
+
+        index.actions.reserve(order.size());
+        for (size_t i : order) {
+            index.actions.push_back(input[i]);
+        }
+        for (size_t i = 0; i < index.actions.size(); i++) {
+            if (index.cycles.empty() || index.cycles.back() != index.actions[i].cycle) {
+                index.cycles.push_back(index.actions[i].cycle);
+                index.offsets.push_back(i);
+            }
+        }
+        index.offsets.push_back(index.actions.size());
+        return index;
+    }
+
+    // Radix LSD de 11 bits por pasada (como mucho 3 para un int no negativo);
+    // cada pasada es un counting sort estable, así que el orden del archivo
+    // se conserva dentro de cada ciclo
+    static void sortByCycle(const std::vector<Action>& input, std::vector<size_t>& order, int top) {
+        constexpr int kBits = 11;
+        constexpr int kDigits = 1 << kBits;
+        std::vector<size_t> scratch(order.size());
+        std::vector<size_t> counts(kDigits + 1);
+        for (int shift = 0; shift == 0 || (top >> shift) > 0; shift += kBits) {
+            std::fill(counts.begin(), counts.end(), 0);
+            for (size_t i : order) {
+                counts[((input[i].cycle >> shift) & (kDigits - 1)) + 1]++;
+            }
+            for (int d = 0; d < kDigits; d++) {
+                counts[d + 1] += counts[d];
+            }
+            for (size_t i : order) {
+                scratch[counts[(input[i].cycle >> shift) & (kDigits - 1)]++] = i;
+            }
+            order.swap(scratch);
+        }
+    }
+
+    size_t buckets() const { return cycles.size(); }
+    size_t begin(size_t bucket) const { return offsets[bucket]; }
+    size_t end(size_t bucket) const { return offsets[bucket + 1]; }
+};
+
+int findRoot(std::vector<int>& parent, int node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+// Orden canónico de los interbloqueos: por ciclo y primer proceso
+bool deadlockOrder(const SyncDeadlock& a, const SyncDeadlock& b) {
+    return a.cycle != b.cycle ? a.cycle < b.cycle : a.pids.front() < b.pids.front();
+}
+
+} // namespace
+
+namespace {
+
+// Pasadas de un ciclo: 0 reintenta las colas liberadas, 1.. las relajadas, y
+// las llegadas (y sus colas relajadas) van desde kArrivalPass
+constexpr int kArrivalPass = 1 << 30;
+
+// Motor de simulación. Se instancia con el tipo concreto del mecanismo para que
+// tryAcquire/release se resuelvan en compilación (y se puedan inlinear) en el
+// ciclo principal; con SynchronizationMechanism usa la interfaz virtual.
+// horizon: último ciclo de llegada de la traza completa cuando se simula solo
+// una parte (las esperas sin resolver se cierran en horizon + 5).
+// emit_order: si no es nulo, recibe por cada tramo la pasada del ciclo en que
+// se abrió y el rango con que se visitó, para intercalar simulaciones parciales
+// en el orden del motor en serie.
+template <class Mechanism>
+SyncLog runSimulation(const std::vector<Process>& processes,
+                      const std::vector<Action>& actions,
+                      Mechanism& mechanism,
+                      int horizon = 0,
+                      std::vector<std::pair<int, int>>* emit_order = nullptr) {
+    
+    SyncLog log;
+    
+    const ActionIndex index = ActionIndex::build(actions);
+    
+    mechanism.resetResources();
+
+    // Internar recursos y procesos una sola vez; el ciclo trabaja con ids
+    const size_t action_count = index.actions.size();
+    std::vector<int> action_resource(action_count);
+    std::vector<int> action_pid(action_count);
+    std::vector<AccessType> action_access(action_count);
+    std::vector<int> action_type(action_count);
+    std::vector<int> action_duration(action_count);
+    for (size_t i = 0; i < action_count; i++) {
+        action_duration[i] = std::max(index.actions[i].duration, 1);
+        action_resource[i] = mechanism.resourceId(index.actions[i].resource);
+        action_pid[i] = mechanism.processId(index.actions[i].pid);
+        action_access[i] = parseAccessType(index.actions[i].type);
+        action_type[i] = log.action_types.intern(index.actions[i].type);
+    }
+    const int resource_count = mechanism.resourceNames().size();
+    const int process_count = mechanism.processNames().size();
+
+    log.colors.assign(process_count, QColor());
+    log.priorities.assign(process_count, -1);
+    for (const auto& process : processes) {
+        int pid = mechanism.processNames().find(process.pid);
+        if (pid >= 0) {
+            log.colors[pid] = process.color;
+            log.priorities[pid] = process.priority;
+        }
+    }
+    
+    // Cola FIFO por recurso con índices de index.actions. Un proceso en espera
+    // se reintenta cuando su recurso se libera o cuando el mecanismo avisa
+    // (onWaitEnd) de que otra salida de la cola relajó la admisión. Fuera de
+    // eso el intento fallaría igual: las adquisiciones solo reducen la
+    // disponibilidad, y las políticas que miran la cola (p. ej. un escritor en
+    // espera que frena a los lectores) solo la amplían cuando alguien sale.
+    // Cada espera abre un tramo WAITING que se cierra al obtener o descartar.
+    std::vector<std::deque<size_t>> resource_queues(resource_count);
+    std::vector<std::vector<size_t>> pid_waiting(process_count);
+    std::vector<long long> open_interval(action_count, -1);
+    std::vector<char> resolved(action_count, 0); // adquirida o descartada
+    size_t waiting_count = 0;
+
+    // Secciones críticas: cada acción obtenida retiene su recurso action_duration
+    // ciclos y se libera al empezar el ciclo en que vence. Si al vencer el
+    // proceso está bloqueado en una petición hecha dentro de la sección, no
+    // puede salir de ella: la liberación se aplaza hasta que deje de esperar.
+    // Vencimientos en una rueda jerárquica: el salto a la siguiente liberación
+    // no depende de lo larga que sea la sección.
+    TimingWheel<size_t> wheel;
+    std::vector<long long> hold_interval(action_count, -1); // tramo ACCESSED abierto
+    std::vector<std::vector<size_t>> deferred(process_count);
+    size_t holding_count = 0;
+    std::vector<int> acquired_cycle(process_count, -1); // un solo acceso nuevo por ciclo
+    std::vector<size_t> acquired_action(process_count, 0); // y con qué acción
+    std::vector<size_t> expired;
+    std::vector<int> released_list;
+    std::vector<char> relaxed(resource_count, 0); // colas a reintentar sin liberación
+    std::vector<int> relaxed_list;
+    std::vector<int> retry_list;
+    std::vector<char> shrunk(resource_count, 0);
+    std::vector<int> shrunk_list;
+
+    // Grafo de espera implícito: un proceso bloqueado apunta a quienes retienen
+    // los recursos que espera. Se actualiza en cada obtención, bloqueo y
+    // liberación, y al final del ciclo solo se revisan los procesos cuyas
+    // aristas cambiaron. Mientras nadie espere reteniendo algo no puede haber
+    // interbloqueo y no se revisa nada.
+    std::vector<std::vector<size_t>> holders(resource_count); // recurso -> acciones que lo retienen
+    std::vector<std::vector<size_t>> pid_holds(process_count);
+    std::vector<int> open_waits(process_count, 0);
+    std::vector<char> dead(process_count, 0);
+    std::vector<char> dirty(process_count, 0);
+    std::vector<int> dirty_list;
+    std::vector<int> seen(process_count, 0);
+    int epoch = 0;
+    bool hold_and_wait = false;
+
+    // Llegadas pendientes: un proceso interbloqueado ya no hace nuevas peticiones
+    std::vector<int> pending_arrivals(process_count, 0);
+    for (size_t i = 0; i < action_count; i++) {
+        pending_arrivals[action_pid[i]]++;
+    }
+    size_t live_arrivals = action_count;
+    
+    int max_cycle = std::max(index.max_cycle, horizon);
+    const bool wake_all = mechanism.releaseWakesAll();
+    const bool ordered = mechanism.ordersWaiters();
+    std::vector<std::pair<int, size_t>> ranked; // (waitRank, acción) a visitar
+    int pass = 0;      // pasada del ciclo en curso (ver emit_order)
+    int pass_rank = 0; // rango de la acción que se está visitando
+    size_t next_bucket = 0;
+    int current_cycle = 0;
+
+    auto markDirty = [&](int pid) {
+        if (hold_and_wait && !dead[pid] && !dirty[pid]) {
+            dirty[pid] = 1;
+            dirty_list.push_back(pid);
+        }
+    };
+
+    auto markWaitersDirty = [&](int resource) {
+        if (!hold_and_wait) return;
+        for (size_t j : resource_queues[resource]) {
+            if (!resolved[j]) markDirty(action_pid[j]);
+        }
+    };
+
+    auto markShrunk = [&](int resource) {
+        if (!shrunk[resource]) {
+            shrunk[resource] = 1;
+            shrunk_list.push_back(resource);
+        }
+    };
+
+    // Sale de la espera: el tramo WAITING termina el ciclo anterior
+    auto leaveWaiting = [&](size_t i) {
+        resolved[i] = 1;
+        if (open_interval[i] >= 0) {
+            log.intervals[open_interval[i]].end_cycle = current_cycle - 1;
+            open_interval[i] = -1;
+            waiting_count--;
+            if (mechanism.onWaitEnd(action_resource[i], action_pid[i], action_access[i]) &&
+                !relaxed[action_resource[i]]) {
+                relaxed[action_resource[i]] = 1;
+                relaxed_list.push_back(action_resource[i]);
+            }
+            markShrunk(action_resource[i]);
+            if (--open_waits[action_pid[i]] > 0) {
+                markDirty(action_pid[i]);
+            }
+
+            // Las secciones aplazadas se vuelven a revisar el ciclo siguiente
+            auto& pending = deferred[action_pid[i]];
+            for (size_t held : pending) {
+                wheel.push(current_cycle + 1, held);
+            }
+            pending.clear();
+        }
+    };
+
+    // ¿Espera el proceso algo que pidió después de obtener `held`?
+    auto blockedInside = [&](size_t held) {
+        const int since = log.intervals[hold_interval[held]].start_cycle;
+        for (size_t j : pid_waiting[action_pid[held]]) {
+            if (!resolved[j] && open_interval[j] >= 0 && log.intervals[open_interval[j]].start_cycle > since) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // ¿Todo lo alcanzable desde `start` en el grafo de espera está bloqueado
+    // sin salida? Cada proceso alcanzado espera solo recursos retenidos por
+    // procesos igual de bloqueados y que no pueden soltarlos (piden algo
+    // desde dentro de la sección). Si es así, se marcan en `fresh`.
+    std::vector<int> reached;
+    std::vector<int> fresh;
+    auto detectFrom = [&](int start) {
+        epoch++;
+        reached.clear();
+        std::vector<int> stack{start};
+        seen[start] = epoch;
+        while (!stack.empty()) {
+            int pid = stack.back();
+            stack.pop_back();
+            if (dead[pid]) continue;
+            if (open_waits[pid] == 0) return false;
+            reached.push_back(pid);
+            for (size_t j : pid_waiting[pid]) {
+                if (resolved[j] || open_interval[j] < 0) continue;
+                const auto& owners = holders[action_resource[j]];
+                if (owners.empty()) return false;
+                for (size_t held : owners) {
+                    int owner = action_pid[held];
+                    if (!dead[owner] && open_waits[owner] == 0) return false;
+                    if (!blockedInside(held)) return false;
+                    if (seen[owner] != epoch) {
+                        seen[owner] = epoch;
+                        stack.push_back(owner);
+                    }
+                }
+            }
+        }
+
+        for (int pid : reached) {
+            dead[pid] = 1;
+            live_arrivals -= pending_arrivals[pid];
+            fresh.push_back(pid);
+        }
+
+        // Quienes esperan a los recién bloqueados pueden haber quedado atrapados
+        for (int pid : reached) {
+            for (size_t held : pid_holds[pid]) {
+                markWaitersDirty(action_resource[held]);
+            }
+        }
+        return true;
+    };
+
+    // Un registro por grupo conexo (por aristas de espera) de los procesos que
+    // quedaron bloqueados en este ciclo; no depende del orden de revisión
+    std::vector<int> fresh_group(process_count, -1);
+    auto recordDeadlocks = [&]() {
+        std::vector<int> parent(fresh.size());
+        for (size_t k = 0; k < fresh.size(); k++) {
+            parent[k] = static_cast<int>(k);
+            fresh_group[fresh[k]] = static_cast<int>(k);
+        }
+        for (int pid : fresh) {
+            for (size_t j : pid_waiting[pid]) {
+                if (resolved[j] || open_interval[j] < 0) continue;
+                for (size_t held : holders[action_resource[j]]) {
+                    int other = fresh_group[action_pid[held]];
+                    if (other < 0) continue;
+                    int a = findRoot(parent, fresh_group[pid]);
+                    int b = findRoot(parent, other);
+                    if (a != b) parent[a] = b;
+                }
+            }
+        }
+
+        std::vector<int> slot(fresh.size(), -1);
+        const size_t first = log.deadlocks.size();
+        for (size_t k = 0; k < fresh.size(); k++) {
+            int root = findRoot(parent, static_cast<int>(k));
+            if (slot[root] < 0) {
+                slot[root] = static_cast<int>(log.deadlocks.size());
+                log.deadlocks.push_back(SyncDeadlock{current_cycle, {}, {}});
+            }
+            SyncDeadlock& deadlock = log.deadlocks[slot[root]];
+            deadlock.pids.push_back(fresh[k]);
+            for (size_t j : pid_waiting[fresh[k]]) {
+                if (!resolved[j] && open_interval[j] >= 0) {
+                    deadlock.resources.push_back(action_resource[j]);
+                }
+            }
+        }
+        for (size_t d = first; d < log.deadlocks.size(); d++) {
+            auto& deadlock = log.deadlocks[d];
+            std::sort(deadlock.pids.begin(), deadlock.pids.end());
+            std::sort(deadlock.resources.begin(), deadlock.resources.end());
+            deadlock.resources.erase(std::unique(deadlock.resources.begin(), deadlock.resources.end()),
+                                     deadlock.resources.end());
+        }
+        for (int pid : fresh) {
+            fresh_group[pid] = -1;
+        }
+        fresh.clear();
+    };
+
+    auto visit = [&](size_t i) {
+        const int pid = action_pid[i];
+        const int resource = action_resource[i];
+        
+        // Un proceso obtiene como mucho un recurso por ciclo. Tras obtenerlo,
+        // sus acciones posteriores a la que lo obtuvo se descartan y las
+        // anteriores siguen esperando (o empiezan a esperar) sin intentarlo hasta el
+        // ciclo siguiente. La regla es la misma con colas por prioridad: el
+        // orden de visita (rango, llegada) solo decide cuál obtiene primero.
+        const bool acquired_now = acquired_cycle[pid] == current_cycle;
+        if (acquired_now && i > acquired_action[pid]) {
+            leaveWaiting(i);
+            return;
+        }
+        
+        if (!acquired_now && mechanism.tryAcquire(resource, pid, action_access[i])) {
+            // Proceso obtiene recurso
+            const int waited = open_interval[i] >= 0
+                ? current_cycle - log.intervals[open_interval[i]].start_cycle : 0;
+            leaveWaiting(i);
+            acquired_cycle[pid] = current_cycle;
+            acquired_action[pid] = i;
+            hold_interval[i] = static_cast<long long>(log.intervals.size());
+            holding_count++;
+            holders[resource].push_back(i);
+            pid_holds[pid].push_back(i);
+            // El traspaso, si el mecanismo lo cobra, alarga la ocupación
+            const int hold = action_duration[i] + mechanism.acquireCost(resource, pid, waited);
+            wheel.push(current_cycle + hold, i);
+            log.intervals.push_back(SyncInterval(pid, resource, action_type[i], ProcessState::ACCESSED,
+                                                 current_cycle, current_cycle, static_cast<int>(i)));
+            if (emit_order) emit_order->push_back({pass, pass_rank});
+
+            // Sus otras acciones en espera que venían detrás se descartan;
+            // las anteriores siguen esperando
+            auto& others = pid_waiting[pid];
+            std::vector<size_t> kept;
+            for (size_t j : others) {
+                if (resolved[j]) continue;
+                if (j > i) {
+                    leaveWaiting(j);
+                } else {
+                    kept.push_back(j);
+                }
+            }
+            others.swap(kept);
+        } else if (open_interval[i] < 0) {
+            // Recurso ocupado, empieza a esperar
+            open_interval[i] = static_cast<long long>(log.intervals.size());
+            log.intervals.push_back(SyncInterval(pid, resource, action_type[i], ProcessState::WAITING,
+                                                 current_cycle, current_cycle, static_cast<int>(i)));
+            if (emit_order) emit_order->push_back({pass, pass_rank});
+            resource_queues[resource].push_back(i);
+            pid_waiting[pid].push_back(i);
+            waiting_count++;
+            open_waits[pid]++;
+            mechanism.onWait(resource, pid, action_access[i]);
+
+            // Espera reteniendo: sus secciones ya no se liberan mientras siga aquí
+            if (!pid_holds[pid].empty()) {
+                hold_and_wait = true;
+                markDirty(pid);
+                for (size_t held : pid_holds[pid]) {
+                    markWaitersDirty(action_resource[held]);
+                }
+            }
+        }
+    };
+
+    auto dropHold = [](std::vector<size_t>& list, size_t i) {
+        auto it = std::find(list.begin(), list.end(), i);
+        *it = list.back();
+        list.pop_back();
+    };
+    
+    // Reintenta las colas de `list` (de todos los recursos si `all`),
+    // intercaladas en orden de llegada o por prioridad
+    auto retryQueues = [&](const std::vector<int>& list, bool all) {
+        using Cursor = std::tuple<size_t, size_t, int>; // acción, posición, recurso
+        std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heads;
+        if (ordered) {
+            // Por prioridad efectiva al empezar el ciclo; a igualdad, por llegada
+            ranked.clear();
+            auto collect = [&](int resource) {
+                for (size_t i : resource_queues[resource]) {
+                    if (!resolved[i]) ranked.push_back({mechanism.waitRank(action_pid[i]), i});
+                }
+            };
+            if (all) {
+                for (int resource = 0; resource < resource_count; resource++) collect(resource);
+            } else {
+                for (int resource : list) collect(resource);
+            }
+            std::sort(ranked.begin(), ranked.end());
+            for (const auto& entry : ranked) {
+                pass_rank = entry.first;
+                if (!resolved[entry.second]) visit(entry.second);
+            }
+        } else if (all) {
+            for (int resource = 0; resource < resource_count; resource++) {
+                if (!resource_queues[resource].empty()) {
+                    heads.push({resource_queues[resource].front(), 0, resource});
+                }
+            }
+        } else {
+            for (int resource : list) {
+                if (!resource_queues[resource].empty()) {
+                    heads.push({resource_queues[resource].front(), 0, resource});
+                }
+            }
+        }
+        pass_rank = 0;
+        while (!heads.empty()) {
+            auto [i, pos, resource] = heads.top();
+            heads.pop();
+            if (!resolved[i]) {
+                visit(i);
+            }
+            const auto& queue = resource_queues[resource];
+            if (pos + 1 < queue.size()) {
+                heads.push({queue[pos + 1], pos + 1, resource});
+            }
+        }
+    };
+
+    // Las colas que el mecanismo relajó se reintentan en el mismo ciclo,
+    // hasta que ninguna salida relaje otra
+    auto retryRelaxed = [&]() {
+        while (!relaxed_list.empty()) {
+            pass++;
+            retry_list.swap(relaxed_list);
+            relaxed_list.clear();
+            for (int resource : retry_list) relaxed[resource] = 0;
+            std::sort(retry_list.begin(), retry_list.end());
+            retryQueues(retry_list, false);
+        }
+    };
+    
+    // Solo se visitan ciclos con llegadas o liberaciones
+    while (current_cycle <= max_cycle + 5) {
+        log.last_cycle = current_cycle;
+        
+        // Liberar las secciones críticas que vencen en este ciclo
+        released_list.clear();
+        expired.clear();
+        wheel.popUntil(current_cycle, expired);
+        for (size_t i : expired) {
+            if (blockedInside(i)) {
+                deferred[action_pid[i]].push_back(i);
+                continue;
+            }
+            mechanism.release(action_resource[i], action_pid[i]);
+            released_list.push_back(action_resource[i]);
+            log.intervals[hold_interval[i]].end_cycle = current_cycle - 1;
+            hold_interval[i] = -1;
+            holding_count--;
+            dropHold(holders[action_resource[i]], i);
+            dropHold(pid_holds[action_pid[i]], i);
+        }
+        std::sort(released_list.begin(), released_list.end());
+        released_list.erase(std::unique(released_list.begin(), released_list.end()), released_list.end());
+
+        // Reintentar las colas de los recursos liberados, y después las que
+        // se relajaron al resolverse esas esperas
+        pass = 0;
+        retryQueues(released_list, wake_all && !released_list.empty());
+        retryRelaxed();
+
+        // Las llegadas de este ciclo van detrás de todos los que ya esperaban
+        if (next_bucket < index.buckets() && index.cycles[next_bucket] == current_cycle) {
+            pass = kArrivalPass;
+            pass_rank = 0;
+            ranked.clear();
+            for (size_t i = index.begin(next_bucket); i < index.end(next_bucket); i++) {
+                const int pid = action_pid[i];
+                pending_arrivals[pid]--;
+                if (dead[pid]) {
+                    resolved[i] = 1;
+                    continue;
+                }
+                live_arrivals--;
+                if (ordered) {
+                    ranked.push_back({mechanism.waitRank(pid), i});
+                } else {
+                    visit(i);
+                }
+            }
+            // Entre las llegadas del mismo ciclo también pasa antes la más prioritaria
+            std::sort(ranked.begin(), ranked.end());
+            for (const auto& entry : ranked) {
+                pass_rank = entry.first;
+                visit(entry.second);
+            }
+            next_bucket++;
+            retryRelaxed();
+        }
+
+        // Los que siguen esperando un recurso liberado cambiaron de aristas
+        for (int resource : released_list) {
+            markWaitersDirty(resource);
+        }
+        for (size_t k = 0; k < dirty_list.size(); k++) {
+            int pid = dirty_list[k];
+            if (!dead[pid] && open_waits[pid] > 0) {
+                detectFrom(pid);
+            }
+        }
+        for (int pid : dirty_list) {
+            dirty[pid] = 0;
+        }
+        dirty_list.clear();
+        if (!fresh.empty()) {
+            recordDeadlocks();
+        }
+
+        // Compactar las colas que perdieron procesos
+        for (int resource : shrunk_list) {
+            auto& queue = resource_queues[resource];
+            queue.erase(std::remove_if(queue.begin(), queue.end(),
+                [&resolved](size_t i) { return resolved[i] != 0; }), queue.end());
+            shrunk[resource] = 0;
+        }
+        shrunk_list.clear();
+        
+        // Saltar a la siguiente liberación o llegada, la que venga antes. Si
+        // solo quedan procesos interbloqueados ya no cambiará nada.
+        if (wheel.empty() && live_arrivals == 0) {
+            break;
+        } else if (!wheel.empty()) {
+            int next = static_cast<int>(wheel.nextTime());
+            if (next_bucket < index.buckets()) {
+                next = std::min(next, index.cycles[next_bucket]);
+            }
+            current_cycle = next;
+        } else if (next_bucket < index.buckets()) {
+            current_cycle = index.cycles[next_bucket];
+        } else {
+            break;
+        }
+    }
+
+    // Quienes siguen esperando (o reteniendo) lo hacen hasta el último ciclo simulado
+    if (waiting_count > 0 || holding_count > 0) {
+        log.last_cycle = max_cycle + 5;
+    }
+    for (size_t i = 0; i < action_count; i++) {
+        if (open_interval[i] >= 0) {
+            log.intervals[open_interval[i]].end_cycle = max_cycle + 5;
+        }
+        if (hold_interval[i] >= 0) {
+            log.intervals[hold_interval[i]].end_cycle = max_cycle + 5;
+        }
+    }
+
+    std::sort(log.deadlocks.begin(), log.deadlocks.end(), deadlockOrder);
+    log.processes = mechanism.processNames();
+    log.resources = mechanism.resourceNames();
+    return log;
+}
+
+
+SyncLog dispatchSimulation(const std::vector<Process>& processes,
+                           const std::vector<Action>& actions,
+                           SynchronizationMechanism* mechanism,
+                           int horizon = 0,
+                           std::vector<std::pair<int, int>>* emit_order = nullptr) {
+    if (auto* mutex = dynamic_cast<MutexLock*>(mechanism)) {
+        return runSimulation(processes, actions, *mutex, horizon, emit_order);
+    }
+    if (auto* semaphore = dynamic_cast<Semaphore*>(mechanism)) {
+        return runSimulation(processes, actions, *semaphore, horizon, emit_order);
+    }
+    if (auto* banker = dynamic_cast<Banker*>(mechanism)) {
+        return runSimulation(processes, actions, *banker, horizon, emit_order);
+    }
+    if (auto* costed = dynamic_cast<CostModelLock*>(mechanism)) {
+        return runSimulation(processes, actions, *costed, horizon, emit_order);
+    }
+    if (auto* rcu = dynamic_cast<RCULock*>(mechanism)) {
+        return runSimulation(processes, actions, *rcu, horizon, emit_order);
+    }
+    if (auto* seqlock = dynamic_cast<SeqLock*>(mechanism)) {
+        return runSimulation(processes, actions, *seqlock, horizon, emit_order);
+    }
+    return runSimulation(processes, actions, *mechanism, horizon, emit_order);
+}
+
+// Por debajo de este tamaño repartir en hilos cuesta más de lo que ahorra
+const size_t kParallelMinActions = 1 << 12;
+
+// Procesos y recursos que nunca comparten acciones no se afectan entre sí: cada
+// componente conexa del grafo proceso-recurso se simula por separado. Las
+// componentes se reparten en `threads` grupos balanceados por número de
+// acciones y cada grupo corre en su hilo con su propia copia del mecanismo.
+// Los ids de proceso y recurso son los mismos que asignaría la simulación en
+// serie, así que basta con traducir índices de acción y tipos al unir.
+SyncLog simulatePartitioned(const std::vector<Process>& processes,
+                            const std::vector<Action>& actions,
+                            SynchronizationMechanism* mechanism,
+                            unsigned threads) {
+    const ActionIndex index = ActionIndex::build(actions);
+    const size_t action_count = index.actions.size();
+
+    // Internar en el mismo orden que el motor en serie
+    SyncLog log;
+    std::vector<int> action_resource(action_count);
+    std::vector<int> action_pid(action_count);
+    for (size_t i = 0; i < action_count; i++) {
+        action_resource[i] = mechanism->resourceId(index.actions[i].resource);
+        action_pid[i] = mechanism->processId(index.actions[i].pid);
+        log.action_types.intern(index.actions[i].type);
+    }
+    const int process_count = mechanism->processNames().size();
+    const int resource_count = mechanism->resourceNames().size();
+
+    // Union-find: procesos en [0, P), recursos en [P, P + R)
+    std::vector<int> parent(process_count + resource_count);
+    for (size_t node = 0; node < parent.size(); node++) {
+        parent[node] = static_cast<int>(node);
+    }
+    for (size_t i = 0; i < action_count; i++) {
+        int a = findRoot(parent, action_pid[i]);
+        int b = findRoot(parent, process_count + action_resource[i]);
+        if (a != b) {
+            parent[a] = b;
+        }
+    }
+
+    std::vector<int> component_of(parent.size(), -1);
+    std::vector<size_t> component_size;
+    std::vector<int> action_component(action_count);
+    for (size_t i = 0; i < action_count; i++) {
+        int root = findRoot(parent, action_pid[i]);
+        if (component_of[root] < 0) {
+            component_of[root] = static_cast<int>(component_size.size());
+            component_size.push_back(0);
+        }
+        action_component[i] = component_of[root];
+        component_size[action_component[i]]++;
+    }
+
+    const size_t component_count = component_size.size();
+    threads = static_cast<unsigned>(std::min<size_t>(threads, component_count));
+    std::vector<std::unique_ptr<SynchronizationMechanism>> copies;
+    if (threads > 1) {
+        for (unsigned t = 0; t < threads; t++) {
+            copies.push_back(mechanism->clone());
+            if (!copies.back()) break;
+        }
+    }
+    if (threads <= 1 || copies.size() < threads || !copies.back()) {
+        return dispatchSimulation(processes, actions, mechanism);
+    }
+
+    // Componentes más grandes primero, cada una al grupo con menos acciones
+    std::vector<size_t> by_size(component_count);
+    for (size_t c = 0; c < component_count; c++) by_size[c] = c;
+    std::stable_sort(by_size.begin(), by_size.end(), [&](size_t a, size_t b) {
+        return component_size[a] > component_size[b];
+    });
+    std::vector<unsigned> component_group(component_count);
+    std::vector<size_t> group_load(threads, 0);
+    for (size_t c : by_size) {
+        unsigned group = static_cast<unsigned>(
+            std::min_element(group_load.begin(), group_load.end()) - group_load.begin());
+        component_group[c] = group;
+        group_load[group] += component_size[c];
+    }
+
+    // Cada grupo conserva el orden global, así su orden de llegada coincide
+    std::vector<std::vector<Action>> group_actions(threads);
+    std::vector<std::vector<int>> group_members(threads); // índice local -> global
+    for (size_t i = 0; i < action_count; i++) {
+        unsigned group = component_group[action_component[i]];
+        group_actions[group].push_back(index.actions[i]);
+        group_members[group].push_back(static_cast<int>(i));
+    }
+
+    std::vector<SyncLog> partial(threads);
+    std::vector<std::vector<std::pair<int, int>>> emit_order(threads);
+    std::vector<std::thread> workers;
+    const std::vector<Process> no_processes;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            partial[t] = dispatchSimulation(no_processes, group_actions[t], copies[t].get(), index.max_cycle,
+                                            &emit_order[t]);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Unir en el orden en que el motor en serie abre los tramos: por ciclo,
+    // pasada, rango de visita (prioridad en ordersWaiters) y acción
+    using EmitKey = std::tuple<int, int, int, int>;
+    std::vector<std::pair<EmitKey, SyncInterval>> merged;
+    for (unsigned t = 0; t < threads; t++) {
+        std::vector<int> types(partial[t].action_types.size());
+        for (int k = 0; k < static_cast<int>(types.size()); k++) {
+            types[k] = log.action_types.find(partial[t].action_types.name(k));
+        }
+        for (size_t k = 0; k < partial[t].intervals.size(); k++) {
+            SyncInterval interval = partial[t].intervals[k];
+            interval.action = group_members[t][interval.action];
+            interval.type = types[interval.type];
+            merged.push_back({EmitKey{interval.start_cycle, emit_order[t][k].first, emit_order[t][k].second,
+                                      interval.action}, interval});
+        }
+        log.last_cycle = std::max(log.last_cycle, partial[t].last_cycle);
+        log.deadlocks.insert(log.deadlocks.end(), partial[t].deadlocks.begin(), partial[t].deadlocks.end());
+    }
+    std::sort(log.deadlocks.begin(), log.deadlocks.end(), deadlockOrder);
+    std::sort(merged.begin(), merged.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    log.intervals.reserve(merged.size());
+    for (const auto& entry : merged) {
+        log.intervals.push_back(entry.second);
+    }
+
+    log.processes = mechanism->processNames();
+    log.resources = mechanism->resourceNames();
+    log.colors.assign(process_count, QColor());
+    log.priorities.assign(process_count, -1);
+    for (const auto& process : processes) {
+        int pid = log.processes.find(process.pid);
+        if (pid >= 0) {
+            log.colors[pid] = process.color;
+            log.priorities[pid] = process.priority;
+        }
+    }
+    return log;
+}
+
+} // namespace
+
+SyncLog SynchronizationSimulator::simulateSynchronizationLog(
+    const std::vector<Process>& processes,
+    const std::vector<Resource>& resources,
+    const std::vector<Action>& actions,
+    SynchronizationMechanism* mechanism,
+    unsigned threads) {
+    
+    if (threads == 0) {
+        threads = actions.size() < kParallelMinActions ? 1 : std::thread::hardware_concurrency();
+    }
+    if (threads > 1) {
+        return simulatePartitioned(processes, actions, mechanism, threads);
+    }
+    return dispatchSimulation(processes, actions, mechanism);
+}
+
+RWReport SyncLog::rwReport() const {
+    RWReport report;
+    const int write_type = action_types.find("WRITE");
+    const int read_type = action_types.find("READ");
+
+    // Por acción: inicio de la espera y del acceso (-1 si no hubo)
+    int actions = 0;
+    for (const auto& interval : intervals) {
+        actions = std::max(actions, interval.action + 1);
+    }
+    std::vector<int> wait_start(actions, -1);
+    std::vector<int> access_start(actions, -1);
+    std::vector<char> is_write(actions, 0);
+    for (const auto& interval : intervals) {
+        if (interval.state == ProcessState::WAITING) {
+            wait_start[interval.action] = interval.start_cycle;
+        } else {
+            access_start[interval.action] = interval.start_cycle;
+            if (interval.type == write_type) report.writes++;
+            if (interval.type == read_type) report.reads++;
+        }
+        is_write[interval.action] = interval.type == write_type;
+    }
+
+    std::vector<int> waits;
+    for (int a = 0; a < actions; a++) {
+        if (!is_write[a]) continue;
+        if (access_start[a] < 0) {
+            if (wait_start[a] >= 0) report.starved_writers++;
+            continue;
+        }
+        waits.push_back(wait_start[a] >= 0 ? access_start[a] - wait_start[a] : 0);
+    }
+    std::sort(waits.begin(), waits.end());
+    if (!waits.empty()) {
+        report.writer_wait_p50 = nearestRank(waits, 50);
+        report.writer_wait_p95 = nearestRank(waits, 95);
+        report.writer_wait_p99 = nearestRank(waits, 99);
+        report.writer_wait_max = waits.back();
+    }
+    report.throughput = static_cast<double>(report.reads + report.writes) / (last_cycle + 1);
+    return report;
+}
+
+ReadMostlyReport SyncLog::readMostlyReport() const {
+    ReadMostlyReport report;
+    const int read_type = action_types.find("READ");
+    std::vector<int> writer_waits;
+    for (const auto& interval : intervals) {
+        const bool read = interval.type == read_type;
+        if (interval.state == ProcessState::ACCESSED) {
+            (read ? report.reads : report.writes)++;
+        } else if (read) {
+            report.reader_wait_max = std::max(report.reader_wait_max, interval.end_cycle - interval.start_cycle + 1);
+        } else {
+            writer_waits.push_back(interval.end_cycle - interval.start_cycle + 1);
+        }
+    }
+    if (!writer_waits.empty()) {
+        std::sort(writer_waits.begin(), writer_waits.end());
+        report.writer_wait_p99 = nearestRank(writer_waits, 99);
+    }
+    report.read_throughput = static_cast<double>(report.reads) / (last_cycle + 1);
+    return report;
+}
+
+std::vector<PriorityBlocking> SyncLog::priorityBlocking() const {
+    // Tramos [start, end] con la prioridad más baja (número mayor) entre
+    // quienes retienen algo; un proceso sin prioridad cuenta como el más bajo
+    struct Step {
+        int start;
+        int end;
+        int lowest;
+    };
+    auto priorityOf = [this](int pid) {
+        int priority = pid < static_cast<int>(priorities.size()) ? priorities[pid] : -1;
+        return priority < 0 ? INT_MAX : priority;
+    };
+    using Bound = std::tuple<int, int, int>; // (ciclo, +1 entra / -1 sale, prioridad)
+    auto buildSteps = [](std::vector<Bound>& bounds) {
+        std::sort(bounds.begin(), bounds.end());
+        std::vector<Step> steps;
+        std::multiset<int> active;
+        for (size_t k = 0; k < bounds.size();) {
+            const int cycle = std::get<0>(bounds[k]);
+            for (; k < bounds.size() && std::get<0>(bounds[k]) == cycle; k++) {
+                if (std::get<1>(bounds[k]) > 0) {
+                    active.insert(std::get<2>(bounds[k]));
+                } else {
+                    active.erase(active.find(std::get<2>(bounds[k])));
+                }
+            }
+            if (!active.empty() && k < bounds.size()) {
+                steps.push_back(Step{cycle, std::get<0>(bounds[k]) - 1, *active.rbegin()});
+            }
+        }
+        return steps;
+    };
+
+    std::vector<Bound> all_bounds;
+    std::vector<std::vector<Bound>> resource_bounds(resources.size());
+    for (const auto& interval : intervals) {
+        if (interval.state != ProcessState::ACCESSED) continue;
+        const int priority = priorityOf(interval.pid);
+        for (auto* bounds : {&all_bounds, &resource_bounds[interval.resource]}) {
+            bounds->push_back({interval.start_cycle, 1, priority});
+            bounds->push_back({interval.end_cycle + 1, -1, priority});
+        }
+    }
+    const std::vector<Step> held_anywhere = buildSteps(all_bounds);
+    std::vector<std::vector<Step>> held_by(resources.size());
+    for (int r = 0; r < resources.size(); r++) {
+        held_by[r] = buildSteps(resource_bounds[r]);
+    }
+
+    // Ciclos de [from, to] cubiertos por `steps` con alguien por debajo de
+    // `priority`; onGap recibe los huecos sin tramo
+    auto lowerCycles = [](const std::vector<Step>& steps, int from, int to, int priority, auto&& onGap) {
+        int cycles = 0;
+        int cursor = from;
+        auto it = std::lower_bound(steps.begin(), steps.end(), from,
+                                   [](const Step& step, int cycle) { return step.end < cycle; });
+        for (; it != steps.end() && it->start <= to; ++it) {
+            const int a = std::max(from, it->start);
+            const int b = std::min(to, it->end);
+            if (cursor < a) cycles += onGap(cursor, a - 1);
+            if (it->lowest > priority) cycles += b - a + 1;
+            cursor = b + 1;
+        }
+        if (cursor <= to) cycles += onGap(cursor, to);
+        return cycles;
+    };
+    auto noGap = [](int, int) { return 0; };
+
+    std::vector<PriorityBlocking> report;
+    std::vector<int> slot(processes.size(), -1);
+    for (int pid = 0; pid < processes.size(); pid++) {
+        if (pid < static_cast<int>(priorities.size()) && priorities[pid] >= 0) {
+            slot[pid] = static_cast<int>(report.size());
+            PriorityBlocking entry;
+            entry.pid = pid;
+            entry.priority = priorities[pid];
+            report.push_back(entry);
+        }
+    }
+    for (const auto& interval : intervals) {
+        if (interval.state != ProcessState::WAITING || interval.end_cycle < interval.start_cycle) continue;
+        if (slot[interval.pid] < 0) continue;
+        PriorityBlocking& entry = report[slot[interval.pid]];
+        const int blocked = interval.end_cycle - interval.start_cycle + 1;
+        // Recurso retenido: cuenta quien lo retiene; libre: cualquiera que retenga algo
+        const int inversion = lowerCycles(held_by[interval.resource], interval.start_cycle, interval.end_cycle,
+                                          entry.priority, [&](int from, int to) {
+            return lowerCycles(held_anywhere, from, to, entry.priority, noGap);
+        });
+        entry.blocked_cycles += blocked;
+        entry.inversion_cycles += inversion;
+        entry.worst_blocking = std::max(entry.worst_blocking, blocked);
+        entry.worst_inversion = std::max(entry.worst_inversion, inversion);
+    }
+    std::sort(report.begin(), report.end(), [](const PriorityBlocking& a, const PriorityBlocking& b) {
+        return a.priority != b.priority ? a.priority < b.priority : a.pid < b.pid;
+    });
+    return report;
+}
+
+std::vector<SyncEvent> SyncLog::toEvents() const {
+    // (ciclo, acción, tramo) por cada ciclo cubierto
+    std::vector<std::tuple<int, int, size_t>> order;
+    for (size_t k = 0; k < intervals.size(); k++) {
+        for (int cycle = intervals[k].start_cycle; cycle <= intervals[k].end_cycle; cycle++) {
+            order.emplace_back(cycle, intervals[k].action, k);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<SyncEvent> events;
+    events.reserve(order.size());
+    for (const auto& [cycle, action, k] : order) {
+        const SyncInterval& interval = intervals[k];
+        events.push_back(SyncEvent(processes.name(interval.pid), resources.name(interval.resource),
+                                   action_types.name(interval.type), cycle, interval.state,
+                                   colors[interval.pid]));
+    }
+    return events;
+}
+
+std::vector<SyncEvent> SynchronizationSimulator::simulateSynchronization(
+    const std::vector<Process>& processes,
+    const std::vector<Resource>& resources,
+    const std::vector<Action>& actions,
+    SynchronizationMechanism* mechanism,
+    unsigned threads) {
+    
+    return simulateSynchronizationLog(processes, resources, actions, mechanism, threads).toEvents();
+}
+
+ProcessStateIndex::ProcessStateIndex(const std::vector<Process>& processes, const SyncLog& log) {
+    // Dentro de un ciclo los eventos van por acción y luego por tramo, como en toEvents
+    std::vector<size_t> order(log.intervals.size());
+    for (size_t k = 0; k < order.size(); k++) {
+        order[k] = k;
+    }
+    std::stable_sort(order.begin(), order.end(), [&log](size_t a, size_t b) {
+        return log.intervals[a].action < log.intervals[b].action;
+    });
+
+    std::vector<QString> owners;
+    for (size_t k : order) {
+        const SyncInterval& interval = log.intervals[k];
+        if (interval.end_cycle < 0) continue;
+        spans.push_back(Span{std::max(interval.start_cycle, 0), interval.end_cycle, 0,
+                             log.resources.name(interval.resource), log.action_types.name(interval.type),
+                             interval.state, log.colors[interval.pid]});
+        owners.push_back(log.processes.name(interval.pid));
+    }
+    build(processes, owners);
+}
+
+ProcessStateIndex::ProcessStateIndex(const std::vector<Process>& processes, const std::vector<SyncEvent>& events) {
+    std::vector<const SyncEvent*> sorted;
+    for (const auto& event : events) {
+        if (event.cycle >= 0) sorted.push_back(&event);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const SyncEvent* a, const SyncEvent* b) {
+            return a->cycle < b->cycle;
+        });
+
+    std::vector<QString> owners;
+    spans.reserve(sorted.size());
+    for (const SyncEvent* event : sorted) {
+        spans.push_back(Span{event->cycle, event->cycle, 0, event->resource,
+                             event->action_type, event->state, event->color});
+        owners.push_back(event->pid);
+    }
+    build(processes, owners);
+}
+
+void ProcessStateIndex::build(const std::vector<Process>& processes, const std::vector<QString>& owners) {
+    // Un lugar por pid, en orden de pid. Los que solo aparecen en tramos
+    // existen desde su primer evento y sin color, como en getProcessStates.
+    std::map<QString, size_t> slots;
+    for (const auto& process : processes) {
+        slots[process.pid] = 0;
+    }
+    for (const auto& pid : owners) {
+        slots[pid] = 0;
+    }
+    initial.resize(slots.size());
+    listed.assign(slots.size(), false);
+    segments.assign(slots.size(), {});
+    size_t next_slot = 0;
+    names.clear();
+    for (auto& [pid, slot] : slots) {
+        slot = next_slot++;
+        names.push_back(pid);
+    }
+    for (const auto& process : processes) {
+        size_t slot = slots[process.pid];
+        initial[slot] = SyncProcessState(process.pid, process.color);
+        listed[slot] = true;
+    }
+    for (size_t i = 0; i < spans.size(); i++) {
+        spans[i].slot = slots[owners[i]];
+    }
+
+    // Totales y máximo de eventos en un ciclo (barrido por los bordes)
+    std::vector<std::pair<int, int>> bounds;
+    bounds.reserve(2 * spans.size());
+    for (const auto& span : spans) {
+        const long long length = static_cast<long long>(span.end) - span.start + 1;
+        event_total += length;
+        if (span.state == ProcessState::ACCESSED) accessed_total += length;
+        bounds.push_back({span.start, 1});
+        bounds.push_back({span.end + 1, -1});
+    }
+    std::sort(bounds.begin(), bounds.end());
+    long long open = 0;
+    for (const auto& bound : bounds) {
+        open += bound.second;
+        max_per_cycle = std::max(max_per_cycle, static_cast<size_t>(open));
+    }
+
+    // Árbol de máximos de `end` sobre los tramos ordenados por inicio
+    by_start.resize(spans.size());
+    for (size_t i = 0; i < spans.size(); i++) {
+        by_start[i] = i;
+        last_cycle = std::max(last_cycle, spans[i].end);
+    }
+    std::stable_sort(by_start.begin(), by_start.end(),
+        [this](size_t a, size_t b) { return spans[a].start < spans[b].start; });
+    tree_size = 1;
+    while (tree_size < spans.size()) tree_size *= 2;
+    max_end.assign(2 * tree_size, INT_MIN);
+    for (size_t i = 0; i < spans.size(); i++) {
+        max_end[tree_size + i] = spans[by_start[i]].end;
+    }
+    for (size_t node = tree_size - 1; node > 0; node--) {
+        max_end[node] = std::max(max_end[2 * node], max_end[2 * node + 1]);
+    }
+
+    // Segmentos por proceso: entre dos bordes de sus tramos, el conjunto de
+    // tramos activos no cambia y cada ciclo repite los mismos eventos
+    std::vector<std::vector<size_t>> owned(initial.size());
+    for (size_t i = 0; i < spans.size(); i++) {
+        owned[spans[i].slot].push_back(i);
+    }
+    std::vector<std::pair<int, long long>> edges; // (ciclo, +tramo o -tramo-1)
+    std::set<size_t> active;
+    for (size_t slot = 0; slot < owned.size(); slot++) {
+        edges.clear();
+        for (size_t i : owned[slot]) {
+            edges.push_back({spans[i].start, static_cast<long long>(i)});
+            edges.push_back({spans[i].end + 1, -static_cast<long long>(i) - 1});
+        }
+        std::sort(edges.begin(), edges.end());
+        active.clear();
+        int carried = 0;
+        for (size_t e = 0; e < edges.size();) {
+            const int from = edges[e].first;
+            for (; e < edges.size() && edges[e].first == from; e++) {
+                if (edges[e].second >= 0) {
+                    active.insert(static_cast<size_t>(edges[e].second));
+                } else {
+                    active.erase(static_cast<size_t>(-edges[e].second - 1));
+                }
+            }
+            if (active.empty() || e == edges.size()) continue;
+            const int to = edges[e].first - 1;
+
+            // Como al aplicar los eventos del ciclo en orden: el último da el
+            // estado, el último WAITING el recurso, y cada ACCESSED reinicia
+            // la cuenta de espera
+            Segment segment{from, to, spans[*active.rbegin()].state, "", 0, 0};
+            int waiting_after = 0;
+            bool accessed = false;
+            bool resource_found = false;
+            for (auto it = active.rbegin(); it != active.rend() && !(accessed && resource_found); ++it) {
+                if (spans[*it].state == ProcessState::WAITING) {
+                    if (!resource_found) {
+                        segment.waiting_for_resource = spans[*it].resource;
+                        resource_found = true;
+                    }
+                    if (!accessed) waiting_after++;
+                } else {
+                    accessed = true;
+                }
+            }
+            if (accessed) {
+                segment.waiting_base = waiting_after;
+            } else {
+                segment.waiting_base = carried;
+                segment.waiting_step = waiting_after;
+            }
+            carried = segment.waitingAt(to);
+            segments[slot].push_back(segment);
+        }
+    }
+}
+
+std::vector<size_t> ProcessStateIndex::overlapping(int from, int to) const {
+    // Los que empiezan antes de `to` y cuyo end llega a `from`: se baja por el
+    // árbol solo donde el máximo alcanza
+    std::vector<size_t> found;
+    const size_t begun = std::upper_bound(by_start.begin(), by_start.end(), to,
+        [this](int cycle, size_t i) { return cycle < spans[i].start; }) - by_start.begin();
+    if (begun == 0) {
+        return found;
+    }
+    std::vector<std::pair<size_t, std::pair<size_t, size_t>>> stack{{1, {0, tree_size}}};
+    while (!stack.empty()) {
+        auto [node, range] = stack.back();
+        stack.pop_back();
+        if (range.first >= begun || max_end[node] < from) continue;
+        if (node >= tree_size) {
+            found.push_back(by_start[node - tree_size]);
+            continue;
+        }
+        size_t middle = (range.first + range.second) / 2;
+        stack.push_back({2 * node + 1, {middle, range.second}});
+        stack.push_back({2 * node, {range.first, middle}});
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+std::vector<QString> ProcessStateIndex::activeProcesses() const {
+    std::vector<char> seen(initial.size(), 0);
+    for (const auto& span : spans) {
+        seen[span.slot] = 1;
+    }
+    std::vector<QString> pids;
+    for (size_t slot = 0; slot < initial.size(); slot++) {
+        if (seen[slot]) pids.push_back(names[slot]);
+    }
+    return pids;
+}
+
+std::vector<SyncEvent> ProcessStateIndex::eventsInWindow(int from, int to) const {
+    from = std::max(from, 0);
+    if (from > to) {
+        return {};
+    }
+    std::vector<std::pair<int, size_t>> order; // (ciclo, tramo)
+    for (size_t i : overlapping(from, to)) {
+        for (int cycle = std::max(from, spans[i].start); cycle <= std::min(to, spans[i].end); cycle++) {
+            order.push_back({cycle, i});
+        }
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<SyncEvent> events;
+    events.reserve(order.size());
+    for (const auto& [cycle, i] : order) {
+        const Span& span = spans[i];
+        events.push_back(SyncEvent(names[span.slot], span.resource, span.action_type, cycle, span.state, span.color));
+    }
+    return events;
+}
+
+SyncProcessState ProcessStateIndex::stateOf(size_t slot, int cycle, bool& exists) const {
+    const auto& history = segments[slot];
+    auto it = std::upper_bound(history.begin(), history.end(), cycle,
+        [](int c, const Segment& segment) {
+            return c < segment.from;
+        });
+
+    SyncProcessState state = initial[slot];
+    if (it == history.begin()) {
+        exists = listed[slot];
+        return state;
+    }
+
+    --it;
+    exists = true;
+    if (cycle <= it->to) {
+        state.current_state = it->state;
+        state.waiting_for_resource = it->waiting_for_resource;
+        state.cycles_waiting = it->waitingAt(cycle);
+    } else {
+        state.cycles_waiting = it->waitingAt(it->to);
+    }
+    return state;
+}
+
+std::vector<SyncProcessState> ProcessStateIndex::stateAt(int cycle) const {
+    std::vector<SyncProcessState> states;
+    for (size_t slot = 0; slot < initial.size(); slot++) {
+        bool exists = false;
+        SyncProcessState state = stateOf(slot, cycle, exists);
+        if (exists) {
+            states.push_back(state);
+        }
+    }
+    return states;
+}
+
+std::vector<SyncProcessState> ProcessStateIndex::diff(int from, int to) const {
+    // Sin tramos entre ambos ciclos, un proceso conserva su estado
+    int low = std::min(from, to);
+    int high = std::max(from, to);
+    std::vector<size_t> touched;
+    for (size_t i : overlapping(low, high)) {
+        touched.push_back(spans[i].slot);
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+    std::vector<SyncProcessState> changed;
+    for (size_t slot : touched) {
+        bool existed = false;
+        bool exists = false;
+        SyncProcessState before = stateOf(slot, from, existed);
+        SyncProcessState after = stateOf(slot, to, exists);
+        if (!exists) {
+            continue;
+        }
+        if (!existed || before.current_state != after.current_state ||
+            before.waiting_for_resource != after.waiting_for_resource ||
+            before.cycles_waiting != after.cycles_waiting) {
+            changed.push_back(after);
+        }
+    }
+    return changed;
+}
+
+std::vector<SyncProcessState> SynchronizationSimulator::getProcessStates(
+    const std::vector<Process>& processes,
+    const std::vector<SyncEvent>& events,
+    int maxCycles) {
+    
+    ProcessStateIndex index(processes, events);
+    std::vector<SyncProcessState> states;
+    
+    for (int cycle = 0; cycle <= maxCycles; cycle++) {
+        std::vector<SyncProcessState> snapshot = index.stateAt(cycle);
+        states.insert(states.end(), snapshot.begin(), snapshot.end());
+    }
+    
+    return states;
+}
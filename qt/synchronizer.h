@@ -7,7 +7,9 @@
 #include <queue>
 #include <QTableWidget>
 #include <QHeaderView>
+#include <QHash>
 #include <algorithm>
+#include <memory>
 
 enum class ProcessState {
     ACCESSED,
@@ -42,60 +44,517 @@ struct SyncProcessState {
         : pid(p), current_state(ProcessState::WAITING), waiting_for_resource(""), cycles_waiting(0), color(c) {}
 };
 
+enum class AccessType {
+    READ,
+    WRITE,
+    OTHER
+};
+
+AccessType parseAccessType(const QString& action_type);
+
+// Nombres internados: cada nombre distinto recibe un id denso 0..n-1
+class NameTable {
+private:
+    QHash<QString, int> ids;
+    std::vector<QString> names;
+
+public:
+    int intern(const QString& name);
+    int find(const QString& name) const; // -1 si no existe
+    const QString& name(int id) const { return names[id]; }
+    int size() const { return static_cast<int>(names.size()); }
+    void clear();
+};
+
 class SynchronizationMechanism {
 public:
     virtual ~SynchronizationMechanism() = default;
-    virtual bool tryAcquire(const QString& resource, const QString& pid, const QString& action_type) = 0;
-    virtual void release(const QString& resource, const QString& pid) = 0;
-    virtual bool isAvailable(const QString& resource) const = 0;
+
+    // Interfaz por ids densos (ver resourceId/processId). Un id de recurso
+    // que el mecanismo aún no registra se trata como recurso recién creado.
+    virtual bool tryAcquire(int resource, int pid, AccessType type) = 0;
+    virtual void release(int resource, int pid) = 0;
+    virtual bool isAvailable(int resource) const = 0;
     virtual void resetResources() = 0;
+    // Copia independiente (mismos nombres y recursos) para simular en otro
+    // hilo; nullptr si el mecanismo no se puede copiar y hay que ir en serie.
+    virtual std::unique_ptr<SynchronizationMechanism> clone() const { return nullptr; }
+    // true si una liberación puede desbloquear esperas en otros recursos: el
+    // motor reintenta entonces todas las colas, no solo la del liberado
+    virtual bool releaseWakesAll() const { return false; }
+    // Avisos del motor al entrar y salir de la cola de espera de un recurso
+    // (al salir, ya sea porque obtuvo el recurso o porque se descartó).
+    // onWaitEnd devuelve true si la salida puede admitir a otros que esperan
+    // ese recurso sin que se libere (p. ej. un escritor en cola que frenaba a
+    // los lectores): el motor reintenta entonces su cola.
+    virtual void onWait(int resource, int pid, AccessType type) {}
+    virtual bool onWaitEnd(int resource, int pid, AccessType type) { return false; }
+    // true si las colas se atienden por prioridad y no por orden de llegada:
+    // el motor reintenta primero a quien tenga menor waitRank
+    virtual bool ordersWaiters() const { return false; }
+    virtual int waitRank(int pid) const { return 0; }
+    // Ciclos extra que el recurso queda ocupado al obtenerlo (traspaso del
+    // cerrojo al nuevo dueño); `waited` son los ciclos que pasó en la cola
+    virtual int acquireCost(int resource, int pid, int waited) { return 0; }
+
+    // Interfaz por nombre: interna y delega en la versión por id
+    bool tryAcquire(const QString& resource, const QString& pid, const QString& action_type);
+    void release(const QString& resource, const QString& pid);
+    bool isAvailable(const QString& resource) const;
+
+    int resourceId(const QString& resource) { return resource_names.intern(resource); }
+    int processId(const QString& pid) { return process_names.intern(pid); }
+    const NameTable& resourceNames() const { return resource_names; }
+    const NameTable& processNames() const { return process_names; }
+
+protected:
+    // Id de consulta para un nombre: uno sin registrar si el nombre es desconocido
+    int lookupResource(const QString& resource) const;
+
+    NameTable resource_names;
+    NameTable process_names;
 };
 
-class MutexLock : public SynchronizationMechanism {
+// Protocolo de MutexLock frente a la inversión de prioridad
+enum class PriorityProtocol {
+    NONE,        // colas por prioridad, sin más
+    INHERITANCE, // quien retiene hereda la prioridad de quienes lo esperan
+    CEILING      // techo inmediato: quien retiene sube al techo del recurso
+};
+
+class MutexLock final : public SynchronizationMechanism {
 private:
-    std::map<QString, QString> resource_owners;  // recurso -> PID (quien lo tiene)
+    std::vector<int> owners;  // recurso -> id del proceso que lo tiene (-1 libre)
     std::vector<Resource> resources;
 
+    // Solo con prioridades (número menor = más prioridad)
+    bool prioritized = false;
+    PriorityProtocol protocol = PriorityProtocol::NONE;
+    std::vector<int> base_priority;          // por id de proceso
+    std::vector<int> ceilings;               // por recurso: prioridad más alta de quienes lo usan
+    std::vector<std::vector<int>> waiters;   // recurso -> procesos en su cola
+    std::vector<std::vector<int>> held;      // proceso -> recursos que retiene
+    mutable std::vector<int> seen;           // recorrido de la herencia
+    mutable std::vector<int> stack;
+    mutable int epoch = 0;
+
+    void ensureResource(int resource);
+    void ensureProcess(int pid);
+    int basePriority(int pid) const;
+    int ceilingOf(int resource) const;
+
 public:
     MutexLock(const std::vector<Resource>& res);
-    bool tryAcquire(const QString& resource, const QString& pid, const QString& action_type) override;
-    void release(const QString& resource, const QString& pid) override;
-    bool isAvailable(const QString& resource) const override;
+    // Con prioridades: las de `processes`, techos deducidos de `actions`
+    MutexLock(const std::vector<Resource>& res, const std::vector<Process>& processes,
+              const std::vector<Action>& actions, PriorityProtocol protocol);
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
     void resetResources() override;
+    std::unique_ptr<SynchronizationMechanism> clone() const override;
+    void onWait(int resource, int pid, AccessType type) override;
+    bool onWaitEnd(int resource, int pid, AccessType type) override;
+    bool ordersWaiters() const override { return prioritized; }
+    int waitRank(int pid) const override; // prioridad efectiva
+    PriorityProtocol priorityProtocol() const { return protocol; }
     
     // Métodos auxiliares (mantengo para compatibilidad, pero simplificados)
     bool hasWriter(const QString& resource) const;
     bool hasReaders(const QString& resource) const;
 };
 
-class Semaphore : public SynchronizationMechanism {
+// Política de entrada de lectores y escritores en Semaphore
+enum class RWPolicy {
+    READER_PREFERENCE, // los lectores entran mientras no haya escritor dentro
+    WRITER_PREFERENCE, // un escritor en espera detiene a los lectores nuevos
+    PHASE_FAIR         // alternan: tras cada escritor pasan los lectores que esperaban
+};
+
+class Semaphore final : public SynchronizationMechanism {
 private:
-    std::map<QString, int> resource_counts;           // Cupos disponibles
-    std::map<QString, std::vector<QString>> resource_holders; // Quién tiene el recurso
-    std::map<QString, int> max_counts;                // Contador máximo original
-    std::map<QString, QString> current_writers;       //  Escritor activo por recurso
-    std::map<QString, std::vector<QString>> current_readers; //  Lectores activos
+    // Estado plano indexado por id de recurso
+    std::vector<int> available_counts;    // Cupos disponibles
+    std::vector<int> max_counts;          // Contador máximo original
+    std::vector<int> writers;             // Escritor activo por recurso (-1 ninguno)
+    std::vector<int> reader_counts;       // Lectores activos
+    std::vector<std::vector<int>> reading; // proceso -> recursos que está leyendo
     std::vector<Resource> resources;
 
+    // Colas por recurso según la política
+    RWPolicy policy;
+    std::vector<int> waiting_writers;
+    std::vector<int> waiting_readers;
+    std::vector<int> read_phase;          // lectores que aún pasan antes del próximo escritor (PHASE_FAIR)
+    std::vector<int> phase_epoch;         // escritores liberados por recurso (PHASE_FAIR)
+    std::vector<std::vector<std::pair<int, int>>> read_waits; // proceso -> (recurso, phase_epoch al empezar a esperar)
+
+    void ensureResource(int resource);
+    void ensureProcess(int pid);
+
 public:
-    Semaphore(const std::vector<Resource>& res);
-    bool tryAcquire(const QString& resource, const QString& pid, const QString& action_type) override;
-    void release(const QString& resource, const QString& pid) override;
-    bool isAvailable(const QString& resource) const override;
+    Semaphore(const std::vector<Resource>& res, RWPolicy rw_policy = RWPolicy::READER_PREFERENCE);
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
     void resetResources() override;
+    std::unique_ptr<SynchronizationMechanism> clone() const override;
+    void onWait(int resource, int pid, AccessType type) override;
+    bool onWaitEnd(int resource, int pid, AccessType type) override;
+    RWPolicy rwPolicy() const { return policy; }
     int getAvailableCount(const QString& resource) const;
     
     bool hasActiveWriter(const QString& resource) const;
     int getActiveReaders(const QString& resource) const;
 };
 
+struct SyncLog;
+
+// Métricas de lectores y escritores para comparar RCULock y SeqLock con el
+// semáforo; los costes propios solo los llenan esos dos
+struct ReadMostlyReport {
+    int reads = 0;                // lecturas obtenidas
+    int writes = 0;               // escrituras obtenidas
+    int reader_wait_max = 0;      // ciclos en cola de un lector (solo por el motor)
+    int writer_wait_p99 = 0;      // ciclos en cola de los escritores
+    int read_retries = 0;         // lecturas repetidas por solaparse con una escritura
+    long long retry_cycles = 0;   // ciclos que añaden esas repeticiones
+    int writer_cost_p50 = 0;      // ciclos que paga el escritor tras su sección
+    int writer_cost_p99 = 0;
+    int writer_cost_max = 0;
+    double read_throughput = 0.0; // lecturas terminadas por ciclo simulado
+};
+
+// Lectores que nunca esperan y escritores excluyentes entre sí. Base común de
+// RCULock y SeqLock: solo difieren en lo que paga cada lado, que se calcula
+// sobre el registro porque no retrasa a nadie más.
+class ReaderFreeLock : public SynchronizationMechanism {
+protected:
+    std::vector<int> writers;               // recurso -> escritor dentro (-1 ninguno)
+    std::vector<std::vector<int>> readers;  // recurso -> lectores dentro
+    std::vector<Resource> resources;
+
+    void ensureResource(int resource);
+
+public:
+    ReaderFreeLock(const std::vector<Resource>& res);
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
+    void resetResources() override;
+};
+
+// Read-copy-update: el escritor publica una copia nueva al terminar su sección
+// y, antes de liberar la vieja, espera un periodo de gracia a que salgan los
+// lectores que ya estaban dentro (synchronize_rcu)
+class RCULock final : public ReaderFreeLock {
+private:
+    int grace_period; // ciclos mínimos para detectar que todos pasaron por un estado quieto
+
+public:
+    RCULock(const std::vector<Resource>& res, int grace_cycles = 2);
+    std::unique_ptr<SynchronizationMechanism> clone() const override;
+    ReadMostlyReport report(const SyncLog& log) const;
+};
+
+// Seqlock: el escritor incrementa la secuencia al entrar y al salir; un lector
+// que se solapa con una escritura lo nota al terminar y repite la lectura
+// cuando el escritor sale
+class SeqLock final : public ReaderFreeLock {
+public:
+    SeqLock(const std::vector<Resource>& res);
+    std::unique_ptr<SynchronizationMechanism> clone() const override;
+    ReadMostlyReport report(const SyncLog& log) const;
+};
+
+// Algoritmo del banquero: cada acción pide una unidad del recurso y solo se
+// concede si no supera el reclamo declarado del proceso y el estado que deja
+// es seguro (existe un orden en que todos pueden completar sus reclamos).
+// READ y WRITE piden lo mismo. No se parte en hilos: la seguridad depende de
+// todos los procesos a la vez.
+class Banker final : public SynchronizationMechanism {
+private:
+    // Matrices planas proceso x recurso: la fila de p empieza en p * stride
+    std::vector<int> maximum;
+    std::vector<int> allocation;
+    std::vector<int> need;
+    int stride = 0;
+    int rows = 0;
+
+    std::vector<int> totals;        // recurso -> unidades declaradas
+    std::vector<int> available;
+    std::vector<int> held;          // proceso -> unidades retenidas
+    std::vector<int> safe_sequence; // último orden seguro de los procesos que retienen algo
+    std::vector<char> warned;       // proceso -> ya se avisó que excede su reclamo
+    std::vector<Resource> resources;
+    std::vector<Claim> claims;
+
+    // Memoria de trabajo de isSafe
+    std::vector<int> work;
+    std::vector<int> pending;
+    std::vector<int> order;
+
+    void ensureResource(int resource);
+    void ensureProcess(int pid);
+    bool fits(int pid) const;       // need[pid] <= work
+    void reclaim(int pid);          // work += allocation[pid]
+    bool isSafe(int pid, bool newcomer);
+
+public:
+    Banker(const std::vector<Resource>& res, const std::vector<Claim>& claims);
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
+    void resetResources() override;
+    bool releaseWakesAll() const override { return true; }
+    int getAvailableCount(const QString& resource) const;
+
+    // Reclamos que cubren una traza: tantas unidades como acciones del proceso
+    // sobre el recurso, sin pasar del total declarado
+    static std::vector<Claim> claimsFromActions(const std::vector<Action>& actions,
+                                                const std::vector<Resource>& res);
+};
+
+// Implementación del cerrojo que modela CostModelLock
+enum class LockKind {
+    TICKET,   // cola por tickets: todos giran sobre la misma línea de caché
+    MCS,      // cola enlazada: cada uno gira sobre su propio nodo
+    SPIN_PARK // gira un rato y después se duerme en el núcleo
+};
+
+// Costes en ciclos de simulación
+struct LockCosts {
+    int cache_transfer = 1; // llevar la línea del cerrojo a otro núcleo
+    int spin_limit = 4;     // ciclos que gira SPIN_PARK antes de dormirse
+    int context_switch = 3; // dormir o despertar un hilo
+    int cores = 8;          // hilos que pueden girar a la vez; el resto espera fuera de CPU
+};
+
+struct LockCostReport {
+    int acquisitions = 0;
+    int contended = 0;            // obtenidas después de esperar
+    long long wasted_cycles = 0;  // CPU girando o cambiando de contexto
+    long long line_transfers = 0; // viajes de la línea del cerrojo
+    int context_switches = 0;
+    int handoff_p50 = 0;          // ciclos desde que el dueño suelta hasta que el siguiente entra
+    int handoff_p99 = 0;
+    int handoff_max = 0;
+};
+
+// Mutex exclusivo (como MutexLock, en orden de llegada) que cobra el coste de
+// cada adquisición según la implementación: el traspaso alarga la ocupación
+// del recurso y lo que se gira o se duerme cuenta como CPU perdida. Sirve para
+// comparar implementaciones sobre la misma traza. No se parte en hilos: los
+// totales se acumulan en el mecanismo.
+class CostModelLock final : public SynchronizationMechanism {
+private:
+    LockKind kind;
+    LockCosts costs;
+    std::vector<int> owners;      // recurso -> proceso (-1 libre)
+    std::vector<int> last_owner;  // recurso -> último núcleo con la línea
+    std::vector<int> waiting;     // recurso -> procesos en cola
+    std::vector<Resource> resources;
+    LockCostReport totals;
+    std::vector<int> handoffs;
+
+    void ensureResource(int resource);
+
+public:
+    CostModelLock(const std::vector<Resource>& res, LockKind kind, LockCosts costs = LockCosts());
+    using SynchronizationMechanism::tryAcquire;
+    using SynchronizationMechanism::release;
+    using SynchronizationMechanism::isAvailable;
+    bool tryAcquire(int resource, int pid, AccessType type) override;
+    void release(int resource, int pid) override;
+    bool isAvailable(int resource) const override;
+    void resetResources() override;
+    void onWait(int resource, int pid, AccessType type) override;
+    bool onWaitEnd(int resource, int pid, AccessType type) override;
+    int acquireCost(int resource, int pid, int waited) override;
+    LockKind lockKind() const { return kind; }
+
+    // Totales de la última simulación
+    LockCostReport costReport() const;
+};
+
+// Tramo de ciclos [start_cycle, end_cycle] en que un proceso estuvo en el mismo
+// estado frente a un recurso. Los ids se resuelven con las tablas de SyncLog.
+struct SyncInterval {
+    int pid;
+    int resource;
+    int type;
+    ProcessState state;
+    int start_cycle;
+    int end_cycle;
+    int action; // orden de llegada de la acción que originó el tramo
+
+    SyncInterval() : pid(0), resource(0), type(0), state(ProcessState::WAITING),
+                     start_cycle(0), end_cycle(0), action(0) {}
+
+    SyncInterval(int p, int r, int t, ProcessState s, int start, int end, int a)
+        : pid(p), resource(r), type(t), state(s), start_cycle(start), end_cycle(end), action(a) {}
+};
+
+// Procesos que se esperan entre sí sin poder avanzar: ninguno suelta lo que
+// retiene porque todos piden algo desde dentro de su sección crítica
+struct SyncDeadlock {
+    int cycle;                  // ciclo en que se formó
+    std::vector<int> pids;      // ids en SyncLog::processes
+    std::vector<int> resources; // recursos que esperan (ids en SyncLog::resources)
+};
+
+// Métricas de una corrida para comparar políticas de lectores y escritores
+struct RWReport {
+    int reads = 0;              // accesos READ obtenidos
+    int writes = 0;             // accesos WRITE obtenidos
+    int starved_writers = 0;    // escritores que nunca obtuvieron el recurso
+    int writer_wait_p50 = 0;    // ciclos de espera de los escritores atendidos
+    int writer_wait_p95 = 0;
+    int writer_wait_p99 = 0;
+    int writer_wait_max = 0;
+    double throughput = 0.0;    // accesos obtenidos por ciclo simulado
+};
+
+// Bloqueo sufrido por un proceso con prioridad conocida. Hay inversión en los
+// ciclos en que espera mientras lo que le bloquea es de menor prioridad: quien
+// retiene su recurso o, si el recurso está libre (un mecanismo que lo frena
+// por otra causa), quien retiene cualquier otro.
+struct PriorityBlocking {
+    int pid = 0;                // id en SyncLog::processes
+    int priority = 0;
+    int blocked_cycles = 0;     // ciclos en espera, en total
+    int inversion_cycles = 0;   // de ellos, por inversión
+    int worst_blocking = 0;     // espera más larga
+    int worst_inversion = 0;    // mayor inversión dentro de una sola espera
+};
+
+struct SyncLog {
+    std::vector<SyncInterval> intervals;
+    std::vector<SyncDeadlock> deadlocks; // en orden de ciclo
+    NameTable processes;
+    NameTable resources;
+    NameTable action_types;
+    std::vector<QColor> colors; // por id de proceso
+    std::vector<int> priorities; // por id de proceso (-1 si no se conoce)
+    int last_cycle = 0;
+    size_t max_per_cycle = 0;
+    long long event_total = 0;
+    long long accessed_total = 0;
+
+    // Expande a un SyncEvent por ciclo, ordenados por ciclo y orden de llegada
+    std::vector<SyncEvent> toEvents() const;
+    RWReport rwReport() const;
+    // Lecturas, escrituras, esperas y lecturas por ciclo (sin costes propios)
+    ReadMostlyReport readMostlyReport() const;
+    // Por proceso con prioridad, de más a menos prioritario
+    std::vector<PriorityBlocking> priorityBlocking() const;
+};
+
+// Índice para consultar estados y eventos por ciclo sin expandir la
+// simulación a un evento por ciclo: guarda tramos (un evento por cada ciclo
+// que cubren) y, por proceso, un segmento por cada cambio en los tramos que lo
+// cubren. Memoria proporcional a los tramos. Ignora los ciclos negativos.
+class ProcessStateIndex {
+private:
+    struct Span {
+        int start;
+        int end;                  // inclusive
+        size_t slot;              // proceso (posición en initial)
+        QString resource;
+        QString action_type;
+        ProcessState state;
+        QColor color;
+    };
+
+    // Ciclos [from, to] con los mismos tramos activos. cycles_waiting en el
+    // ciclo c: waiting_base + waiting_step * (c - from + 1)
+    struct Segment {
+        int from;
+        int to;
+        ProcessState state;
+        QString waiting_for_resource;
+        int waiting_base;
+        int waiting_step;
+
+        int waitingAt(int cycle) const { return waiting_base + waiting_step * (cycle - from + 1); }
+    };
+
+    std::vector<Span> spans;          // en el orden de los eventos dentro de un ciclo
+    std::vector<size_t> by_start;     // spans ordenados por inicio
+    std::vector<int> max_end;         // árbol de máximos de end sobre by_start
+    size_t tree_size = 0;
+    std::vector<QString> names;       // pid de cada proceso, ordenados
+    std::vector<SyncProcessState> initial; // un estado por proceso
+    std::vector<bool> listed;         // vino en la lista de procesos (existe desde el ciclo 0)
+    std::vector<std::vector<Segment>> segments;
+    int last_cycle = 0;
+    size_t max_per_cycle = 0;
+    long long event_total = 0;
+    long long accessed_total = 0;
+
+    void build(const std::vector<Process>& processes, const std::vector<QString>& owners);
+    // Tramos que tocan algún ciclo de [from, to], en orden de spans
+    std::vector<size_t> overlapping(int from, int to) const;
+    SyncProcessState stateOf(size_t slot, int cycle, bool& exists) const;
+
+public:
+    ProcessStateIndex() = default;
+    // Directamente de los tramos de la simulación
+    ProcessStateIndex(const std::vector<Process>& processes, const SyncLog& log);
+    // De una lista de eventos (cada uno es un tramo de un ciclo)
+    ProcessStateIndex(const std::vector<Process>& processes, const std::vector<SyncEvent>& events);
+
+    int lastCycle() const { return last_cycle; }
+    size_t maxEventsPerCycle() const { return max_per_cycle; }
+    // Eventos en todos los ciclos, o solo los de un estado
+    long long eventCount() const { return event_total; }
+    long long eventCount(ProcessState state) const {
+        return state == ProcessState::ACCESSED ? accessed_total : event_total - accessed_total;
+    }
+    // Procesos con algún evento, ordenados
+    std::vector<QString> activeProcesses() const;
+
+    // Eventos de los ciclos from..to, por ciclo y orden de llegada
+    std::vector<SyncEvent> eventsInWindow(int from, int to) const;
+
+    // Estado de cada proceso al final del ciclo, ordenado por pid
+    std::vector<SyncProcessState> stateAt(int cycle) const;
+    // Procesos cuyo estado en `to` difiere del que tenían en `from` (con su estado en `to`)
+    std::vector<SyncProcessState> diff(int from, int to) const;
+};
+
 class SynchronizationSimulator {
 public:
+    // Registro compacto: memoria proporcional a los cambios de estado.
+    // threads: 0 elige según el tamaño de la traza y los núcleos, 1 fuerza la
+    // simulación en serie; con más hilos se simulan por separado los grupos de
+    // procesos y recursos independientes (el resultado es el mismo).
+    static SyncLog simulateSynchronizationLog(
+        const std::vector<Process>& processes,
+        const std::vector<Resource>& resources,
+        const std::vector<Action>& actions,
+        SynchronizationMechanism* mechanism,
+        unsigned threads = 0
+    );
+
     static std::vector<SyncEvent> simulateSynchronization(
         const std::vector<Process>& processes,
         const std::vector<Resource>& resources,
         const std::vector<Action>& actions,
-        SynchronizationMechanism* mechanism
+        SynchronizationMechanism* mechanism,
+        unsigned threads = 0
     );
     
     static std::vector<SyncProcessState> getProcessStates(
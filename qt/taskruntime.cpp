@@ -0,0 +1,232 @@
+#include "taskruntime.h"
+#include "loader.h"
+#include <QDebug>
+#include <algorithm>
+#include <exception>
+
+TaskRuntime::TaskRuntime(const TaskRuntimeOptions& options)
+    : config(options), origin(std::chrono::steady_clock::now()) {
+    if (config.workers <= 0) {
+        config.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config.slice_us = std::max(config.slice_us, 1);
+    config.aging_interval_us = std::max(config.aging_interval_us, 1);
+    workers.reserve(config.workers);
+    for (int i = 0; i < config.workers; i++) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+TaskRuntime::~TaskRuntime() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+long long TaskRuntime::nowNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+// Orden de la cola. Para PRIORITY con envejecimiento, runPriority baja un
+// nivel por cada intervalo en cola; eso equivale a ordenar por
+// prioridad·intervalo + instante de encolado, que no cambia con el tiempo y
+// cabe en un montículo (salvo que aquí no hay suelo en prioridad 1)
+long long TaskRuntime::keyFor(const TaskRecord& record, long long enqueued_ns) const {
+    switch (config.policy) {
+    case TaskPolicy::SJF:
+        return record.burst_hint_us;
+    case TaskPolicy::PRIORITY:
+        if (config.aging) {
+            return record.priority * (config.aging_interval_us * 1000LL) + enqueued_ns;
+        }
+        return record.priority;
+    case TaskPolicy::FIFO:
+    case TaskPolicy::ROUND_ROBIN:
+        break;
+    }
+    return 0; // solo cuenta `seq`
+}
+
+void TaskRuntime::enqueue(int index, long long now) {
+    ready.push(Entry{keyFor(pending[index].record, now), seq++, now, index});
+}
+
+void TaskRuntime::submit(Task task, const TaskHints& hints) {
+    submitCooperative([task = std::move(task)](TaskContext&) {
+        task();
+        return true;
+    }, hints);
+}
+
+void TaskRuntime::submitCooperative(CooperativeTask task, const TaskHints& hints) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const long long now = nowNs();
+        int index;
+        if (!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            index = static_cast<int>(pending.size());
+            pending.emplace_back();
+        }
+        Pending& entry = pending[index];
+        entry.task = std::move(task);
+        entry.record = TaskRecord();
+        entry.record.name = hints.name;
+        entry.record.priority = hints.priority;
+        entry.record.burst_hint_us = hints.burst_hint_us;
+        entry.record.submit_ns = now;
+        if (first_submit_ns < 0) first_submit_ns = now;
+        outstanding++;
+        enqueue(index, now);
+    }
+    work_ready.notify_one();
+}
+
+void TaskRuntime::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return outstanding == 0; });
+}
+
+void TaskRuntime::workerLoop() {
+    TaskContext context;
+    context.preemptive = config.policy == TaskPolicy::ROUND_ROBIN;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        work_ready.wait(lock, [this] { return stopping || !ready.empty(); });
+        if (ready.empty()) return; // stopping y sin trabajo
+        const Entry entry = ready.top();
+        ready.pop();
+
+        const long long start = nowNs();
+        // La tarea se saca del vector: `pending` puede crecer mientras corre
+        CooperativeTask task = std::move(pending[entry.record].task);
+        TaskRecord& record = pending[entry.record].record;
+        record.queued_ns += start - entry.enqueued_ns;
+        if (record.start_ns < 0) record.start_ns = start;
+        context.slice_index = record.slices++;
+        const QString name = record.name;
+        lock.unlock();
+
+        context.slice_end = std::chrono::steady_clock::now() + std::chrono::microseconds(config.slice_us);
+        bool done = true;
+        bool failed = false;
+        try {
+            done = task(context);
+        } catch (const std::exception& e) {
+            qDebug() << "Task" << name << "threw:" << e.what();
+            failed = true;
+        } catch (...) {
+            qDebug() << "Task" << name << "threw an unknown exception";
+            failed = true;
+        }
+
+        lock.lock();
+        const long long end = nowNs();
+        Pending& slot = pending[entry.record];
+        slot.record.run_ns += end - start;
+        if (done || failed) {
+            slot.record.finish_ns = end;
+            slot.record.failed = failed;
+            finished.push_back(std::move(slot.record));
+            free_slots.push_back(entry.record);
+            if (--outstanding == 0) {
+                idle.notify_all();
+            }
+        } else {
+            slot.task = std::move(task);
+            enqueue(entry.record, end);
+            // Otro trabajador libre puede tomarla antes que este
+            work_ready.notify_one();
+        }
+    }
+}
+
+std::vector<TaskRecord> TaskRuntime::records() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return finished;
+}
+
+TaskRuntimeStats TaskRuntime::stats() const {
+    TaskRuntimeStats result;
+    std::vector<long long> delays;
+    long long last_finish = 0;
+    long long since = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result.queued = outstanding;
+        since = first_submit_ns;
+        delays.reserve(finished.size());
+        for (const auto& record : finished) {
+            if (record.failed) {
+                result.failed++;
+                continue;
+            }
+            delays.push_back(record.queued_ns);
+            result.avg_first_start_us += (record.start_ns - record.submit_ns) / 1000.0;
+            result.avg_turnaround_us += (record.finish_ns - record.submit_ns) / 1000.0;
+            last_finish = std::max(last_finish, record.finish_ns);
+        }
+    }
+    result.completed = static_cast<long long>(delays.size());
+    if (delays.empty()) return result;
+
+    std::sort(delays.begin(), delays.end());
+    auto percentile = [&delays](double p) {
+        return delays[std::min(delays.size() - 1, static_cast<size_t>(p * delays.size()))] / 1000.0;
+    };
+    for (long long delay : delays) {
+        result.avg_queue_delay_us += delay / 1000.0;
+    }
+    result.avg_queue_delay_us /= result.completed;
+    result.avg_first_start_us /= result.completed;
+    result.avg_turnaround_us /= result.completed;
+    result.p50_queue_delay_us = percentile(0.50);
+    result.p99_queue_delay_us = percentile(0.99);
+    result.max_queue_delay_us = delays.back() / 1000.0;
+    if (last_finish > since) {
+        result.throughput_per_s = result.completed * 1e9 / (last_finish - since);
+    }
+    return result;
+}
+
+void TaskRuntime::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    finished.clear();
+    first_submit_ns = outstanding > 0 ? nowNs() : -1;
+}
+
+std::vector<Process> TaskRuntime::toProcesses(int tick_us) const {
+    const long long tick_ns = std::max(tick_us, 1) * 1000LL;
+    std::vector<TaskRecord> done = records();
+    std::sort(done.begin(), done.end(), [](const TaskRecord& a, const TaskRecord& b) {
+        return a.submit_ns < b.submit_ns;
+    });
+
+    std::vector<Process> processes;
+    processes.reserve(done.size());
+    const long long base = done.empty() ? 0 : done.front().submit_ns;
+    for (const auto& record : done) {
+        if (record.failed) continue;
+        Process process;
+        process.pid = record.name.isEmpty() ? QString("T%1").arg(processes.size() + 1) : record.name;
+        process.arrival_time = static_cast<int>((record.submit_ns - base) / tick_ns);
+        process.burst_time = static_cast<int>(std::max(1LL, (record.run_ns + tick_ns / 2) / tick_ns));
+        process.priority = record.priority;
+        process.remaining_time = process.burst_time;
+        // Lo medido, para compararlo con lo que prediga el simulador
+        process.start_time = static_cast<int>((record.start_ns - base) / tick_ns);
+        process.finish_time = static_cast<int>((record.finish_ns - base) / tick_ns);
+        process.waiting_time = static_cast<int>(record.queued_ns / tick_ns);
+        process.turnaround_time = process.finish_time - process.arrival_time;
+        process.color = processColor(static_cast<int>(processes.size()));
+        processes.push_back(process);
+    }
+    return processes;
+}
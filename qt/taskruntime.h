@@ -0,0 +1,152 @@
+#ifndef TASKRUNTIME_H
+#define TASKRUNTIME_H
+
+#include "utils.h"
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Las mismas políticas que SchedulingAlgorithms, pero sobre tareas reales
+enum class TaskPolicy {
+    FIFO,        // orden de envío
+    SJF,         // menor burst_hint_us primero (sin expropiar)
+    ROUND_ROBIN, // turnos de slice_us; la tarea cede con TaskContext::shouldYield
+    PRIORITY     // menor número = más prioritaria, con envejecimiento opcional
+};
+
+struct TaskRuntimeOptions {
+    TaskPolicy policy = TaskPolicy::FIFO;
+    int workers = 0;              // 0 = std::thread::hardware_concurrency()
+    int slice_us = 1000;          // turno de ROUND_ROBIN
+    bool aging = true;            // PRIORITY: como runPriority(..., agingEnabled, ...)
+    int aging_interval_us = 5000; // gana un nivel de prioridad por cada intervalo en cola
+};
+
+// Lo que se sabe de la tarea al enviarla
+struct TaskHints {
+    QString name;
+    long long burst_hint_us = 0; // estimación para SJF
+    int priority = 0;
+};
+
+// Lo que ve una tarea mientras corre
+class TaskContext {
+public:
+    // En ROUND_ROBIN, true cuando se acabó el turno: la tarea debe guardar
+    // su estado y devolver false para volver al final de la cola
+    bool shouldYield() const {
+        return preemptive && std::chrono::steady_clock::now() >= slice_end;
+    }
+    int slice() const { return slice_index; } // turnos anteriores de esta tarea
+
+private:
+    friend class TaskRuntime;
+    bool preemptive = false;
+    std::chrono::steady_clock::time_point slice_end;
+    int slice_index = 0;
+};
+
+// Una tarea terminada; tiempos en ns desde que se creó el runtime
+struct TaskRecord {
+    QString name;
+    int priority = 0;
+    long long burst_hint_us = 0;
+    long long submit_ns = 0;
+    long long start_ns = -1;   // primer turno
+    long long finish_ns = -1;
+    long long queued_ns = 0;   // suma del tiempo en cola en todos sus turnos
+    long long run_ns = 0;      // suma del tiempo en un trabajador
+    int slices = 0;
+    bool failed = false;       // lanzó una excepción
+};
+
+struct TaskRuntimeStats {
+    long long completed = 0;
+    long long failed = 0;
+    long long queued = 0;            // pendientes o corriendo ahora
+    double avg_queue_delay_us = 0;   // tiempo en cola por tarea (todos sus turnos)
+    double p50_queue_delay_us = 0;
+    double p99_queue_delay_us = 0;
+    double max_queue_delay_us = 0;
+    double avg_first_start_us = 0;   // envío -> primer turno
+    double avg_turnaround_us = 0;    // envío -> fin
+    double throughput_per_s = 0;     // terminadas por segundo desde el primer envío
+};
+
+// Pool de trabajadores que ejecuta callables en el orden de la política.
+// Una sola cola protegida por un mutex: pensado para tareas de decenas de
+// microsegundos en adelante, no para paralelismo de grano fino.
+class TaskRuntime {
+public:
+    using Task = std::function<void()>;
+    // Devuelve true al terminar; false para encolarse de nuevo (ROUND_ROBIN)
+    using CooperativeTask = std::function<bool(TaskContext&)>;
+
+    explicit TaskRuntime(const TaskRuntimeOptions& options = TaskRuntimeOptions());
+    // Termina lo encolado y espera a los trabajadores
+    ~TaskRuntime();
+
+    TaskRuntime(const TaskRuntime&) = delete;
+    TaskRuntime& operator=(const TaskRuntime&) = delete;
+
+    void submit(Task task, const TaskHints& hints = TaskHints());
+    void submitCooperative(CooperativeTask task, const TaskHints& hints = TaskHints());
+
+    // Bloquea hasta que no queda nada en cola ni corriendo
+    void waitIdle();
+
+    const TaskRuntimeOptions& options() const { return config; }
+    std::vector<TaskRecord> records() const;
+    TaskRuntimeStats stats() const;
+    void resetStats();
+
+    // Las tareas terminadas como procesos del simulador (`tick_us` por
+    // unidad), para pasarlas por SchedulingAlgorithms y comparar la
+    // predicción con lo medido
+    std::vector<Process> toProcesses(int tick_us) const;
+
+private:
+    struct Entry {
+        long long key;   // menor primero; depende de la política
+        long long seq;   // desempate: orden de llegada a la cola
+        long long enqueued_ns;
+        int record;      // índice en `pending`
+        bool operator>(const Entry& other) const {
+            return key != other.key ? key > other.key : seq > other.seq;
+        }
+    };
+    struct Pending {
+        CooperativeTask task;
+        TaskRecord record;
+    };
+
+    long long nowNs() const;
+    long long keyFor(const TaskRecord& record, long long enqueued_ns) const;
+    void enqueue(int index, long long now);
+    void workerLoop();
+
+    TaskRuntimeOptions config;
+    std::chrono::steady_clock::time_point origin;
+
+    mutable std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable idle;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready;
+    std::vector<Pending> pending;   // tareas vivas; los huecos se reutilizan
+    std::vector<int> free_slots;
+    std::vector<TaskRecord> finished;
+    long long seq = 0;
+    long long outstanding = 0;
+    long long first_submit_ns = -1;
+    bool stopping = false;
+
+    std::vector<std::thread> workers;
+};
+
+#endif
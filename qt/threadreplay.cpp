@@ -0,0 +1,305 @@
+#include "threadreplay.h"
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+#include <thread>
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Un recurso real; solo se usa la primitiva elegida. Las variantes con
+// tiempo límite permiten rendirse si la traza se interbloquea.
+struct ReplayLock {
+    std::timed_mutex mutex;
+    std::shared_timed_mutex shared;
+    sem_t semaphore;
+};
+
+struct Hold {
+    int resource;
+    bool shared;
+    Clock::time_point until;
+};
+
+// sem_timedwait mide con el reloj de pared: se traduce el plazo del steady_clock
+bool semaphoreWaitUntil(sem_t* semaphore, Clock::time_point deadline) {
+    auto remaining = deadline - Clock::now();
+    if (remaining < Clock::duration::zero()) {
+        remaining = Clock::duration::zero();
+    }
+    timespec limit;
+    clock_gettime(CLOCK_REALTIME, &limit);
+    long long ns = limit.tv_nsec + std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+    limit.tv_sec += static_cast<time_t>(ns / 1000000000LL);
+    limit.tv_nsec = static_cast<long>(ns % 1000000000LL);
+    while (sem_timedwait(semaphore, &limit) != 0) {
+        if (errno != EINTR) return false;
+    }
+    return true;
+}
+
+// Primero sin bloquear, para saber si hubo contención; después hasta el plazo
+bool acquire(ReplayLock& lock, ReplayPrimitive primitive, bool shared,
+             Clock::time_point deadline, bool& contended) {
+    switch (primitive) {
+    case ReplayPrimitive::MUTEX:
+        if (lock.mutex.try_lock()) return true;
+        contended = true;
+        return lock.mutex.try_lock_until(deadline);
+    case ReplayPrimitive::SHARED_MUTEX:
+        if (shared) {
+            if (lock.shared.try_lock_shared()) return true;
+            contended = true;
+            return lock.shared.try_lock_shared_until(deadline);
+        }
+        if (lock.shared.try_lock()) return true;
+        contended = true;
+        return lock.shared.try_lock_until(deadline);
+    case ReplayPrimitive::SEMAPHORE:
+        if (sem_trywait(&lock.semaphore) == 0) return true;
+        contended = true;
+        return semaphoreWaitUntil(&lock.semaphore, deadline);
+    }
+    return false;
+}
+
+void unlock(ReplayLock& lock, ReplayPrimitive primitive, bool shared) {
+    switch (primitive) {
+    case ReplayPrimitive::MUTEX:
+        lock.mutex.unlock();
+        break;
+    case ReplayPrimitive::SHARED_MUTEX:
+        if (shared) {
+            lock.shared.unlock_shared();
+        } else {
+            lock.shared.unlock();
+        }
+        break;
+    case ReplayPrimitive::SEMAPHORE:
+        sem_post(&lock.semaphore);
+        break;
+    }
+}
+
+long long nearestRank(const std::vector<long long>& sorted, int p) {
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void fillWaits(ReplayResourceStats& stats, std::vector<long long>& waits) {
+    if (waits.empty()) return;
+    std::sort(waits.begin(), waits.end());
+    stats.wait_p50_ns = nearestRank(waits, 50);
+    stats.wait_p99_ns = nearestRank(waits, 99);
+    stats.wait_max_ns = waits.back();
+}
+
+} // namespace
+
+ReplayResult ThreadReplay::run(const std::vector<Action>& actions,
+                               const std::vector<Resource>& resources,
+                               ReplayPrimitive primitive,
+                               int cycle_us) {
+    ReplayResult result;
+    result.cycle_us = std::max(cycle_us, 1);
+
+    // Mismo orden que el simulador: por ciclo y, a igualdad, por llegada
+    std::vector<Action> sorted;
+    int max_cycle = 0;
+    for (const auto& action : actions) {
+        max_cycle = std::max(max_cycle, action.cycle + std::max(action.duration, 1) - 1);
+        if (action.cycle >= 0) {
+            sorted.push_back(action);
+        }
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const Action& a, const Action& b) { return a.cycle < b.cycle; });
+
+    std::vector<std::vector<size_t>> by_pid;
+    result.samples.resize(sorted.size());
+    for (size_t k = 0; k < sorted.size(); k++) {
+        ReplaySample& sample = result.samples[k];
+        sample.action = static_cast<int>(k);
+        sample.pid = result.processes.intern(sorted[k].pid);
+        sample.resource = result.resources.intern(sorted[k].resource);
+        if (sample.pid >= static_cast<int>(by_pid.size())) {
+            by_pid.resize(sample.pid + 1);
+        }
+        by_pid[sample.pid].push_back(k);
+    }
+
+    if (by_pid.size() > kMaxThreads) {
+        result.error = QString("%1 procesos, como mucho %2 hilos").arg(by_pid.size()).arg(kMaxThreads);
+        qDebug() << "Thread replay refused:" << result.error;
+        result.samples.clear();
+        return result;
+    }
+
+    const int resource_count = result.resources.size();
+    std::vector<std::unique_ptr<ReplayLock>> locks;
+    for (int r = 0; r < resource_count; r++) {
+        locks.push_back(std::make_unique<ReplayLock>());
+        if (primitive == ReplayPrimitive::SEMAPHORE) {
+            // Igual que Semaphore: un recurso no declarado no tiene cupos
+            unsigned units = 0;
+            for (const auto& resource : resources) {
+                if (resource.name == result.resources.name(r)) {
+                    units = static_cast<unsigned>(std::max(resource.count, 0));
+                }
+            }
+            if (units == 0) {
+                qDebug() << "Resource" << result.resources.name(r) << "has no units; its waits will time out";
+            }
+            sem_init(&locks[r]->semaphore, 0, units);
+        }
+    }
+
+    const auto cycle = std::chrono::microseconds(result.cycle_us);
+    // Margen para crear todos los hilos antes del ciclo 0
+    const auto start = Clock::now() + std::chrono::milliseconds(20)
+                     + std::chrono::microseconds(50) * static_cast<int>(by_pid.size());
+    const auto deadline = start + cycle * (max_cycle + 6);
+
+    // Si falla la creación de un hilo, los ya creados terminan sin pedir nada
+    std::atomic<bool> cancelled(false);
+
+    auto worker = [&](const std::vector<size_t>& mine) {
+        std::vector<Hold> holds;
+        // Suelta, en orden de vencimiento, lo que vence antes de `when`
+        auto releaseDue = [&](Clock::time_point when) {
+            while (!holds.empty()) {
+                auto next = std::min_element(holds.begin(), holds.end(),
+                    [](const Hold& a, const Hold& b) { return a.until < b.until; });
+                if (next->until > when) break;
+                std::this_thread::sleep_until(next->until);
+                unlock(*locks[next->resource], primitive, next->shared);
+                holds.erase(next);
+            }
+        };
+
+        for (size_t k : mine) {
+            const Action& action = sorted[k];
+            ReplaySample& sample = result.samples[k];
+            const auto requested = start + cycle * action.cycle;
+            releaseDue(requested);
+            std::this_thread::sleep_until(requested);
+            if (cancelled) break;
+
+            const bool shared = primitive == ReplayPrimitive::SHARED_MUTEX
+                             && parseAccessType(action.type) == AccessType::READ;
+            const auto asked = Clock::now();
+            bool acquired = false;
+            // Volver a pedir un cerrojo propio no es válido con std::mutex: en
+            // la simulación ese proceso se queda bloqueado, aquí espera al plazo
+            const bool reentrant = primitive != ReplayPrimitive::SEMAPHORE
+                && std::any_of(holds.begin(), holds.end(),
+                               [&](const Hold& hold) { return hold.resource == sample.resource; });
+            if (reentrant) {
+                sample.contended = true;
+                std::this_thread::sleep_until(deadline);
+            } else {
+                acquired = acquire(*locks[sample.resource], primitive, shared, deadline, sample.contended);
+            }
+            const auto got = Clock::now();
+
+            sample.wait_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(got - asked).count();
+            sample.timed_out = !acquired;
+            if (acquired) {
+                sample.acquired_cycle = static_cast<int>((got - start) / cycle);
+                holds.push_back(Hold{sample.resource, shared, got + cycle * std::max(action.duration, 1)});
+            }
+        }
+        releaseDue(Clock::time_point::max());
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(by_pid.size());
+    try {
+        for (const auto& mine : by_pid) {
+            threads.emplace_back(worker, std::cref(mine));
+        }
+    } catch (const std::system_error& e) {
+        cancelled = true;
+        result.error = QString("no se pudieron crear %1 hilos: %2").arg(by_pid.size()).arg(e.what());
+        qDebug() << "Thread replay failed:" << result.error;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (primitive == ReplayPrimitive::SEMAPHORE) {
+        for (auto& lock : locks) {
+            sem_destroy(&lock->semaphore);
+        }
+    }
+
+    if (cancelled) {
+        result.samples.clear();
+        return result;
+    }
+
+    // Resumen por recurso y total
+    result.per_resource.assign(resource_count, ReplayResourceStats());
+    std::vector<std::vector<long long>> waits(resource_count);
+    std::vector<long long> all_waits;
+    for (const auto& sample : result.samples) {
+        for (ReplayResourceStats* stats : {&result.per_resource[sample.resource], &result.total}) {
+            stats->contended += sample.contended ? 1 : 0;
+            stats->timed_out += sample.timed_out ? 1 : 0;
+            stats->acquisitions += sample.timed_out ? 0 : 1;
+        }
+        if (!sample.timed_out) {
+            waits[sample.resource].push_back(sample.wait_ns);
+            all_waits.push_back(sample.wait_ns);
+        }
+    }
+    for (int r = 0; r < resource_count; r++) {
+        fillWaits(result.per_resource[r], waits[r]);
+    }
+    fillWaits(result.total, all_waits);
+    return result;
+}
+
+ReplayComparison ThreadReplay::compare(const ReplayResult& measured, const SyncLog& simulated) {
+    ReplayComparison comparison;
+    std::vector<int> simulated_cycle(measured.samples.size(), -1);
+    std::vector<char> simulated_wait(measured.samples.size(), 0);
+    for (const auto& interval : simulated.intervals) {
+        if (interval.action < 0 || interval.action >= static_cast<int>(measured.samples.size())) continue;
+        if (interval.state == ProcessState::ACCESSED) {
+            simulated_cycle[interval.action] = interval.start_cycle;
+        } else {
+            simulated_wait[interval.action] = 1;
+        }
+    }
+
+    long long error_sum = 0;
+    for (const auto& sample : measured.samples) {
+        const int simulated_at = simulated_cycle[sample.action];
+        comparison.simulated_waits += simulated_wait[sample.action];
+        comparison.measured_waits += sample.contended ? 1 : 0;
+        if (simulated_at >= 0 && sample.acquired_cycle >= 0) {
+            const int error = std::abs(simulated_at - sample.acquired_cycle);
+            comparison.matched++;
+            error_sum += error;
+            comparison.max_abs_error = std::max(comparison.max_abs_error, error);
+        } else if (simulated_at >= 0) {
+            comparison.only_simulated++;
+        } else if (sample.acquired_cycle >= 0) {
+            comparison.only_measured++;
+        }
+    }
+    if (comparison.matched > 0) {
+        comparison.mean_abs_error = static_cast<double>(error_sum) / comparison.matched;
+    }
+    return comparison;
+}
@@ -0,0 +1,76 @@
+#ifndef THREADREPLAY_H
+#define THREADREPLAY_H
+
+#include "utils.h"
+#include "synchronizer.h"
+#include <vector>
+
+// Primitiva real con que se reproduce la traza
+enum class ReplayPrimitive {
+    MUTEX,        // un mutex por recurso: exclusivo, como MutexLock
+    SHARED_MUTEX, // READ compartido y WRITE exclusivo
+    SEMAPHORE     // semáforo POSIX con tantas unidades como el recurso
+};
+
+// Lo medido para una acción; `action` sigue el orden de SyncInterval::action
+struct ReplaySample {
+    int action = 0;
+    int pid = 0;                // ids en ReplayResult::processes
+    int resource = 0;           // ids en ReplayResult::resources
+    long long wait_ns = 0;      // desde que la pidió hasta que la obtuvo o se rindió
+    bool contended = false;     // el intento sin bloquear falló
+    bool timed_out = false;     // no la obtuvo antes del último ciclo de la traza
+    int acquired_cycle = -1;    // ciclo real en que la obtuvo (-1 si se rindió)
+};
+
+struct ReplayResourceStats {
+    int acquisitions = 0;
+    int contended = 0;
+    int timed_out = 0;
+    long long wait_p50_ns = 0;
+    long long wait_p99_ns = 0;
+    long long wait_max_ns = 0;
+};
+
+struct ReplayResult {
+    std::vector<ReplaySample> samples;           // uno por acción con ciclo >= 0
+    std::vector<ReplayResourceStats> per_resource;
+    ReplayResourceStats total;
+    NameTable processes;
+    NameTable resources;
+    int cycle_us = 0;
+    QString error;   // por qué no se reprodujo; vacío si se reprodujo
+};
+
+// Simulado frente a medido, acción por acción
+struct ReplayComparison {
+    int matched = 0;               // acciones obtenidas en ambos
+    int only_simulated = 0;        // obtenidas solo en la simulación
+    int only_measured = 0;         // obtenidas solo con hilos
+    double mean_abs_error = 0.0;   // ciclos de diferencia al obtenerla
+    int max_abs_error = 0;
+    int simulated_waits = 0;       // acciones que esperaron en la simulación
+    int measured_waits = 0;        // y con hilos (intento sin bloquear fallido)
+};
+
+class ThreadReplay {
+public:
+    // Un std::thread por proceso que hace sus acciones en orden de ciclo,
+    // esperando en tiempo real `cycle_us` microsegundos por ciclo. A
+    // diferencia del simulador, un proceso bloqueado no hace más peticiones
+    // hasta obtener la actual. Las esperas se rinden al pasar el último ciclo
+    // de la traza (+5, como el simulador) para que un interbloqueo real no
+    // cuelgue la reproducción. Bloquea hasta terminar: desde la interfaz hay
+    // que llamarlo en otro hilo. Una traza con más de kMaxThreads procesos, o
+    // un fallo al crear los hilos, devuelve el resultado sin muestras y con
+    // `error`.
+    static constexpr size_t kMaxThreads = 512;
+    static ReplayResult run(const std::vector<Action>& actions,
+                            const std::vector<Resource>& resources,
+                            ReplayPrimitive primitive,
+                            int cycle_us = 2000);
+
+    static ReplayComparison compare(const ReplayResult& measured, const SyncLog& simulated);
+};
+
+#endif
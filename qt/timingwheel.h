@@ -0,0 +1,151 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Cola de eventos para instantes enteros no negativos: rueda jerárquica de
+// 64 casillas por nivel. El nivel 0 tiene un instante por casilla; el nivel L
+// agrupa 64^L instantes y se baja de nivel al llegar a ellos, así que cada
+// evento se recoloca como mucho una vez por nivel (O(1) amortizado para
+// insertar y sacar). Un mapa de bits por nivel encuentra la siguiente casilla
+// ocupada sin recorrerlas.
+// Los eventos del mismo instante salen en el orden en que se insertaron.
+template <class T>
+class TimingWheel {
+public:
+    explicit TimingWheel(long long start = 0) : current(std::max(start, 0LL)) {
+        for (auto& minimum : slot_min) minimum = kNever;
+    }
+
+    // `time` < now() se trata como now()
+    void push(long long time, T value) {
+        place(Event{std::max(time, current), seq++, std::move(value)});
+        count++;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    long long now() const { return current; }
+
+    // Instante del próximo evento (requiere !empty())
+    long long nextTime() const {
+        if (occupied[0]) {
+            return (current & ~kMask) | countTrailingZeros(occupied[0]);
+        }
+        for (int level = 1; level < kLevels; level++) {
+            if (occupied[level]) {
+                return slot_min[level * kSlots + countTrailingZeros(occupied[level])];
+            }
+        }
+        return kNever;
+    }
+
+    // Avanza el reloj a `time`, que no puede pasar del próximo evento
+    void advance(long long time) {
+        if (time <= current) return;
+        // De arriba abajo: lo que cae en la casilla de `time` baja de nivel
+        for (int level = kLevels - 1; level > 0; level--) {
+            const int slot = digit(time, level);
+            if (!(occupied[level] & (1ULL << slot))) continue;
+            std::vector<Event> moved;
+            moved.swap(slots[level * kSlots + slot]);
+            occupied[level] &= ~(1ULL << slot);
+            slot_min[level * kSlots + slot] = kNever;
+            current = time;
+            for (auto& event : moved) {
+                place(std::move(event));
+            }
+        }
+        current = time;
+    }
+
+    // Añade a `out` los eventos del próximo instante y devuelve ese instante
+    // (requiere !empty())
+    long long pop(std::vector<T>& out) {
+        const long long time = nextTime();
+        advance(time);
+        const int slot = digit(time, 0);
+        std::vector<Event>& events = slots[slot];
+        // Solo hace falta ordenar si llegaron eventos bajados de otro nivel
+        if (unsorted & (1ULL << slot)) {
+            std::sort(events.begin(), events.end(),
+                      [](const Event& a, const Event& b) { return a.seq < b.seq; });
+        }
+        for (auto& event : events) {
+            out.push_back(std::move(event.value));
+        }
+        count -= events.size();
+        events.clear();
+        occupied[0] &= ~(1ULL << slot);
+        unsorted &= ~(1ULL << slot);
+        return time;
+    }
+
+    // Añade a `out` todos los eventos hasta `time` inclusive, en orden de
+    // instante, y deja el reloj en `time`
+    void popUntil(long long time, std::vector<T>& out) {
+        while (count > 0 && nextTime() <= time) {
+            pop(out);
+        }
+        advance(time);
+    }
+
+    void clear() {
+        for (auto& events : slots) events.clear();
+        for (auto& minimum : slot_min) minimum = kNever;
+        std::fill(std::begin(occupied), std::end(occupied), 0);
+        unsorted = 0;
+        count = 0;
+    }
+
+private:
+    static constexpr int kBits = 6;
+    static constexpr int kSlots = 1 << kBits;
+    static constexpr long long kMask = kSlots - 1;
+    static constexpr int kLevels = 11; // 66 bits: cualquier long long no negativo
+    static constexpr long long kNever = 0x7fffffffffffffffLL;
+
+    struct Event {
+        long long time;
+        unsigned long long seq;
+        T value;
+    };
+
+    static int digit(long long time, int level) {
+        return static_cast<int>((time >> (level * kBits)) & kMask);
+    }
+
+    static int countTrailingZeros(uint64_t bits) {
+        return __builtin_ctzll(bits);
+    }
+
+    // Nivel más bajo en que `time` comparte con el reloj todos los dígitos superiores
+    void place(Event event) {
+        const unsigned long long differ = static_cast<unsigned long long>(event.time ^ current);
+        const int level = differ == 0 ? 0 : (63 - __builtin_clzll(differ)) / kBits;
+        const int slot = digit(event.time, level);
+        const int index = level * kSlots + slot;
+        if (level == 0) {
+            if (!slots[index].empty() && slots[index].back().seq > event.seq) {
+                unsorted |= 1ULL << slot;
+            }
+        } else {
+            slot_min[index] = std::min(slot_min[index], event.time);
+        }
+        occupied[level] |= 1ULL << slot;
+        slots[index].push_back(std::move(event));
+    }
+
+    std::vector<Event> slots[kLevels * kSlots];
+    long long slot_min[kLevels * kSlots]; // instante mínimo de cada casilla (niveles > 0)
+    uint64_t occupied[kLevels] = {};
+    uint64_t unsorted = 0;                // casillas del nivel 0 fuera de orden de inserción
+    long long current;
+    unsigned long long seq = 0;
+    size_t count = 0;
+};
+
+#endif
@@ -52,15 +52,26 @@ struct Resource {
     Resource(QString n, int c, int a) : name(n), count(c), available(a) {}
 };
 
+// Reclamo máximo: unidades de `resource` que `pid` puede llegar a retener a la vez
+struct Claim {
+    QString pid;
+    QString resource;
+    int units;
+
+    Claim() : pid(""), resource(""), units(0) {}
+    Claim(QString p, QString r, int u) : pid(p), resource(r), units(u) {}
+};
+
 struct Action {
     QString pid;     
     QString type;    
     QString resource; 
     int cycle;      
+    int duration;   // ciclos que retiene el recurso una vez obtenido
 
-    Action() : pid(""), type(""), resource(""), cycle(0) {}
-    Action(QString p, QString t, QString r, int c)
-        : pid(p), type(t), resource(r), cycle(c) {}
+    Action() : pid(""), type(""), resource(""), cycle(0), duration(1) {}
+    Action(QString p, QString t, QString r, int c, int d = 1)
+        : pid(p), type(t), resource(r), cycle(c), duration(d) {}
 };
 
 #endif
\ No newline at end of file